@@ -307,6 +307,7 @@
 %catches(storage::HolderNotFoundBySids, storage::WrongNumberOfHolders) storage::Devicegraph::find_holder(sid_t source_sid, sid_t target_sid) const;
 %catches(storage::Exception) storage::Devicegraph::load(const std::string &filename);
 %catches(storage::Exception) storage::Devicegraph::load(const std::string &filename, bool keep_sids);
+%catches(storage::Exception) storage::Devicegraph::load(const std::string &filename, bool keep_sids, bool lazy);
 %catches(storage::DeviceNotFoundBySid) storage::Devicegraph::remove_device(sid_t sid);
 %catches(storage::Exception) storage::Devicegraph::save(const std::string &filename) const;
 %catches(storage::Exception) storage::Devicegraph::write_graphviz(const std::string &filename, DevicegraphStyleCallbacks *style_callbacks, View view) const;
@@ -448,6 +449,7 @@
 %catches(storage::Exception) storage::Storage::remove_pool(const std::string &name);
 %catches(storage::Exception) storage::Storage::rename_pool(const std::string &old_name, const std::string &new_name);
 %catches(storage::Exception) storage::Storage::restore_devicegraph(const std::string &name);
+%catches(storage::Exception) storage::Storage::set_max_parallel_actions(unsigned int max_parallel_actions);
 %catches(storage::DeviceNotFound, storage::DeviceHasWrongType) storage::StrayBlkDevice::find_by_name(Devicegraph *devicegraph, const std::string &name);
 %catches(storage::DeviceNotFound, storage::DeviceHasWrongType) storage::StrayBlkDevice::find_by_name(const Devicegraph *devicegraph, const std::string &name);
 %catches(storage::HolderAlreadyExists) storage::Subdevice::create(Devicegraph *devicegraph, const Device *source, const Device *target);
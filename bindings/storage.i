@@ -10,6 +10,10 @@
 %ignore "operator <<";
 %ignore "get_all_if";
 
+// Scope object to group changes of a devicegraph, not useful for the
+// bindings.
+%ignore storage::Devicegraph::Batch;
+
 %rename("==") "operator==";
 %rename("!=") "operator!=";
 
@@ -21,19 +21,28 @@
  */
 
 
+#include <unordered_map>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
 #include <boost/graph/copy.hpp>
 #include <boost/graph/topological_sort.hpp>
 #include <boost/graph/transitive_reduction.hpp>
 #include <boost/graph/graph_utility.hpp>
 #include <boost/graph/graphviz.hpp>
+#include <boost/functional/hash.hpp>
 
 #include "storage/Utils/Stopwatch.h"
+#include "storage/Utils/WorkerPool.h"
 #include "storage/Utils/CallbacksImpl.h"
 #include "storage/Devices/DeviceImpl.h"
+#include "storage/Holders/HolderImpl.h"
 #include "storage/Devices/BlkDevice.h"
 #include "storage/Devices/PartitionTableImpl.h"
 #include "storage/Devices/LvmVgImpl.h"
 #include "storage/Devices/GptImpl.h"
+#include "storage/Devices/PartitionImpl.h"
+#include "storage/Devices/Msdos.h"
 #include "storage/Devices/BcacheImpl.h"
 #include "storage/Filesystems/BlkFilesystemImpl.h"
 #include "storage/Filesystems/BtrfsImpl.h"
@@ -54,6 +63,9 @@
 #include "storage/Actions/SetQuotaImpl.h"
 #include "storage/Actions/MountImpl.h"
 #include "storage/Actions/UnmountImpl.h"
+#include "storage/Actions/ResizeImpl.h"
+#include "storage/Actions/Create.h"
+#include "storage/Actions/Delete.h"
 #include "storage/EnvironmentImpl.h"
 
 
@@ -114,6 +126,34 @@ namespace storage
     }
 
 
+    void
+    CommitData::flush()
+    {
+	if (etc_fstab_dirty)
+	{
+	    etc_fstab_dirty = false;
+
+	    etc_fstab->log_diff();
+	    etc_fstab->write();
+	}
+
+	if (etc_crypttab_dirty)
+	{
+	    etc_crypttab_dirty = false;
+
+	    etc_crypttab->log();
+	    etc_crypttab->write();
+	}
+
+	if (etc_mdadm_dirty)
+	{
+	    etc_mdadm_dirty = false;
+
+	    etc_mdadm->write();
+	}
+    }
+
+
     class CheckCallbacksLogger : public CheckCallbacks
     {
     public:
@@ -243,7 +283,25 @@ namespace storage
     Actiongraph::Impl::vertex_descriptor
     Actiongraph::Impl::add_vertex(const shared_ptr<Action::Base>& action)
     {
-	return boost::add_vertex(action, graph);
+	vertex_descriptor vertex = boost::add_vertex(vertex_property_t(vertices_by_index.size(), action), graph);
+
+	vertices_by_index.push_back(vertex);
+
+	return vertex;
+    }
+
+
+    void
+    Actiongraph::Impl::remove_vertex(vertex_descriptor vertex)
+    {
+	size_t index = boost::get(boost::vertex_index, graph, vertex);
+	vertex_descriptor last_vertex = vertices_by_index.back();
+	boost::put(boost::vertex_index, graph, last_vertex, index);
+	vertices_by_index[index] = last_vertex;
+	vertices_by_index.pop_back();
+
+	boost::clear_vertex(vertex, graph);
+	boost::remove_vertex(vertex, graph);
     }
 
 
@@ -392,6 +450,139 @@ namespace storage
     }
 
 
+    namespace
+    {
+
+	/**
+	 * Inserts the sids of all ancestors and descendants of the vertex into
+	 * sids.
+	 */
+	void
+	insert_relatives(const Devicegraph::Impl& devicegraph, Devicegraph::Impl::vertex_descriptor vertex,
+			 set<sid_t>& sids)
+	{
+	    set<Devicegraph::Impl::vertex_descriptor> visited;
+
+	    vector<Devicegraph::Impl::vertex_descriptor> todo = { vertex };
+	    while (!todo.empty())
+	    {
+		Devicegraph::Impl::vertex_descriptor tmp = todo.back();
+		todo.pop_back();
+
+		for (Devicegraph::Impl::vertex_descriptor parent : devicegraph.parents_range(tmp, View::ALL))
+		{
+		    if (visited.insert(parent).second)
+		    {
+			sids.insert(devicegraph[parent]->get_sid());
+			todo.push_back(parent);
+		    }
+		}
+	    }
+
+	    todo = { vertex };
+	    while (!todo.empty())
+	    {
+		Devicegraph::Impl::vertex_descriptor tmp = todo.back();
+		todo.pop_back();
+
+		for (Devicegraph::Impl::vertex_descriptor child : devicegraph.children_range(tmp, View::ALL))
+		{
+		    if (visited.insert(child).second)
+		    {
+			sids.insert(devicegraph[child]->get_sid());
+			todo.push_back(child);
+		    }
+		}
+	    }
+	}
+
+
+	/**
+	 * Inserts the sids of the source and target of all holders in lhs that have no
+	 * equal holder with the same sids in rhs into sids.
+	 */
+	void
+	insert_changed_holders(const Devicegraph::Impl& lhs, const Devicegraph::Impl& rhs,
+			       set<sid_t>& sids)
+	{
+	    for (Devicegraph::Impl::edge_descriptor lhs_edge : lhs.edges())
+	    {
+		const Holder* lhs_holder = lhs[lhs_edge];
+
+		const sid_pair_t sid_pair(lhs_holder->get_source_sid(), lhs_holder->get_target_sid());
+
+		bool unchanged = false;
+
+		for (Devicegraph::Impl::edge_descriptor rhs_edge : rhs.find_edges(sid_pair))
+		{
+		    if (*rhs[rhs_edge] == *lhs_holder)
+		    {
+			unchanged = true;
+			break;
+		    }
+		}
+
+		if (!unchanged)
+		{
+		    sids.insert(sid_pair.first);
+		    sids.insert(sid_pair.second);
+		}
+	    }
+	}
+
+    }
+
+
+    set<sid_t>
+    Actiongraph::Impl::get_affected_sids(const vector<sid_t>& created_sids, const vector<sid_t>& common_sids,
+					 const vector<sid_t>& deleted_sids) const
+    {
+	const Devicegraph::Impl& lhs_impl = lhs->get_impl();
+	const Devicegraph::Impl& rhs_impl = rhs->get_impl();
+
+	// Only devices that differ in both devicegraphs, created or deleted
+	// devices and devices with changed holders are modified. Comparing the
+	// devices is much cheaper than adding the modify actions and unlike
+	// recording modifications cannot miss any.
+
+	set<sid_t> modified_sids(created_sids.begin(), created_sids.end());
+	modified_sids.insert(deleted_sids.begin(), deleted_sids.end());
+
+	for (sid_t sid : common_sids)
+	{
+	    const Device* d_lhs = lhs_impl[lhs_impl.find_vertex(sid)];
+	    const Device* d_rhs = rhs_impl[rhs_impl.find_vertex(sid)];
+
+	    if (*d_lhs != *d_rhs)
+		modified_sids.insert(sid);
+	}
+
+	insert_changed_holders(lhs_impl, rhs_impl, modified_sids);
+	insert_changed_holders(rhs_impl, lhs_impl, modified_sids);
+
+	// The modify actions of a device also depend on its ancestors (e.g. the
+	// name of the underlying block device or the extents of a volume group
+	// for reallot) and its descendants (e.g. the mount points of a
+	// filesystem). So all of them are affected by a modification.
+
+	set<sid_t> affected_sids = modified_sids;
+
+	for (sid_t sid : modified_sids)
+	{
+	    if (lhs_impl.device_exists(sid))
+		insert_relatives(lhs_impl, lhs_impl.find_vertex(sid), affected_sids);
+
+	    if (rhs_impl.device_exists(sid))
+		insert_relatives(rhs_impl, rhs_impl.find_vertex(sid), affected_sids);
+	}
+
+	y2mil("affected devices " << affected_sids.size() << " of " << common_sids.size() +
+	      created_sids.size() + deleted_sids.size());
+
+	return affected_sids;
+    }
+
+
     void
     Actiongraph::Impl::get_device_actions()
     {
@@ -418,8 +609,13 @@ namespace storage
 	    d_rhs->get_impl().add_create_actions(*this);
 	}
 
+	const set<sid_t> affected_sids = get_affected_sids(created_sids, common_sids, deleted_sids);
+
 	for (sid_t sid : common_sids)
 	{
+	    if (affected_sids.count(sid) == 0)
+		continue;
+
 	    Devicegraph::Impl::vertex_descriptor v_lhs = lhs->get_impl().find_vertex(sid);
 	    const Device* d_lhs = lhs->get_impl()[v_lhs];
 
@@ -495,27 +691,39 @@ namespace storage
     void
     Actiongraph::Impl::remove_duplicates()
     {
-	vector<pair<vertex_descriptor, vertex_descriptor>> duplicates;
+	// The first mount resp. unmount action for each sid. The position is
+	// used to process the duplicates in the same order as a pairwise
+	// comparison of all actions would.
 
-	boost::iterator_range<vertex_iterator> range = vertices();
+	typedef pair<sid_t, bool> key_t;
 
-	for (vertex_iterator it1 = range.begin(); it1 != range.end(); ++it1)
+	unordered_map<key_t, pair<size_t, vertex_descriptor>, boost::hash<key_t>> firsts;
+
+	vector<pair<size_t, pair<vertex_descriptor, vertex_descriptor>>> tmp;
+
+	size_t position = 0;
+
+	for (vertex_descriptor vertex : vertices())
 	{
-	    const Action::Base* action1 = graph[*it1].get();
+	    const Action::Base* action = graph[vertex].get();
 
-	    for (vertex_iterator it2 = next(it1); it2 != range.end(); ++it2)
+	    const bool mount = is_mount(action);
+	    if (mount || is_unmount(action))
 	    {
-		const Action::Base* action2 = graph[*it2].get();
-
-		if (action1->sid == action2->sid)
-		{
-		    if ((is_mount(action1) && is_mount(action2)) ||
-			(is_unmount(action1) && is_unmount(action2)))
-			duplicates.push_back(make_pair(*it1, *it2));
-		}
+		auto it = firsts.emplace(key_t(action->sid, mount), make_pair(position, vertex)).first;
+		if (it->second.second != vertex)
+		    tmp.emplace_back(it->second.first, make_pair(it->second.second, vertex));
 	    }
+
+	    ++position;
 	}
 
+	stable_sort(tmp.begin(), tmp.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+	vector<pair<vertex_descriptor, vertex_descriptor>> duplicates;
+	for (const auto& t : tmp)
+	    duplicates.push_back(t.second);
+
 	for (pair<vertex_descriptor, vertex_descriptor> duplicate : duplicates)
 	{
 	    for (vertex_descriptor parent : parents(duplicate.second))
@@ -524,8 +732,7 @@ namespace storage
 	    for (vertex_descriptor child : children(duplicate.second))
 		add_edge(duplicate.first, child);
 
-	    clear_vertex(duplicate.second, graph);
-	    remove_vertex(duplicate.second, graph);
+	    remove_vertex(duplicate.second);
 	}
     }
 
@@ -719,8 +926,7 @@ namespace storage
 		for (vertex_descriptor child : children(vertex))
 		    add_edge(parent, child);
 
-	    clear_vertex(vertex, graph);
-	    remove_vertex(vertex, graph);
+	    remove_vertex(vertex);
 	}
     }
 
@@ -761,16 +967,13 @@ namespace storage
     void
     Actiongraph::Impl::calculate_order()
     {
-	VertexIndexMapGenerator<graph_t> vertex_index_map_generator(graph);
-
 	switch (topological_sort_method())
 	{
 	    case 0:
 	    {
 		try
 		{
-		    boost::topological_sort(graph, front_inserter(order),
-					    vertex_index_map(vertex_index_map_generator.get()));
+		    boost::topological_sort(graph, front_inserter(order));
 		}
 		catch (const boost::not_a_dag&)
 		{
@@ -781,7 +984,7 @@ namespace storage
 
 	    case 1:
 	    {
-		order = prioritised_topological_sort(vertex_index_map_generator.get());
+		order = prioritised_topological_sort();
 	    }
 	    break;
 
@@ -817,59 +1020,46 @@ namespace storage
     }
 
 
-    class Actiongraph::Impl::CompareByPriority
-    {
-    public:
-
-	CompareByPriority(const graph_t& graph) : graph(graph) {}
-
-	bool operator()(const vertex_descriptor lhs, const vertex_descriptor rhs) const
-	{
-	    return graph[lhs].get()->priority < graph[rhs].get()->priority;
-	}
-
-    private:
-
-	const graph_t& graph;
-
-    };
-
-
     Actiongraph::Impl::Order
-    Actiongraph::Impl::prioritised_topological_sort(const boost::associative_property_map<vertex_index_map_t>& idx) const
+    Actiongraph::Impl::prioritised_topological_sort() const
     {
 	// Based on Kahn's algorithm.
 
+	const auto idx = boost::get(boost::vertex_index, graph);
+
 	vector<degree_size_type> in_degrees(num_actions());
 
-	// We use vector/deque instead of the obvious priority_queue since we have a few
-	// points below where we can tweak the result (to look more like the plain
-	// topological sort).
-	vector<vertex_descriptor> q;
+	// The ready vertices in one bucket per priority. The next vertex is
+	// taken from the back of the bucket with the highest priority. This
+	// gives the same order as keeping all ready vertices in one vector,
+	// stable sorting it by priority and taking the last one, but without
+	// sorting in every step.
+	map<int, vector<vertex_descriptor>> buckets;
 
 	for (const vertex_descriptor v : vertices())
 	{
 	    if ((in_degrees[idx[v]] = boost::in_degree(v, graph)) == 0)
-		q.push_back(v);						// arbitrary: push_front or push_back
+		buckets[graph[v]->priority].push_back(v);
 	}
 
-	const CompareByPriority compare_by_priority(graph);
-
 	Order order;
 
-	while (!q.empty())
+	while (!buckets.empty())
 	{
-	    stable_sort(q.begin(), q.end(), compare_by_priority);	// arbitrary: stable_sort or sort
+	    const map<int, vector<vertex_descriptor>>::iterator it = prev(buckets.end());
+
+	    const vertex_descriptor v = it->second.back();
+	    it->second.pop_back();
 
-	    const vertex_descriptor v = q.back();
-	    q.pop_back();
+	    if (it->second.empty())
+		buckets.erase(it);
 
 	    order.push_back(v);
 
 	    for (const vertex_descriptor v2 : children(v))
 	    {
 		if (--in_degrees[idx[v2]] == 0)
-		    q.push_back(v2);					// arbitrary: push_front or push_back
+		    buckets[graph[v2]->priority].push_back(v2);
 	    }
 	}
 
@@ -911,6 +1101,40 @@ namespace storage
     }
 
 
+    namespace
+    {
+
+	/**
+	 * Whether the action may need the config files, e.g. /etc/fstab, on
+	 * disk. Mount actions run programs, e.g. the snapper
+	 * installation-helper, that may read them.
+	 */
+	bool
+	needs_config_files(const Action::Base* action)
+	{
+	    return is_mount(action);
+	}
+
+
+	void
+	flush_config_files(CommitData& commit_data, const CommitCallbacks* commit_callbacks)
+	{
+	    try
+	    {
+		commit_data.flush();
+	    }
+	    catch (const Exception& exception)
+	    {
+		ST_CAUGHT(exception);
+
+		// TRANSLATORS: displayed during action
+		error_callback(commit_callbacks, _("Writing configuration files"), exception);
+	    }
+	}
+
+    }
+
+
     void
     Actiongraph::Impl::commit(const CommitOptions& commit_options, const CommitCallbacks* commit_callbacks) const
     {
@@ -923,9 +1147,57 @@ namespace storage
 
 	CommitData commit_data(*this, Tense::PRESENT_CONTINUOUS);
 
-	for (const vertex_descriptor vertex : order)
+	try
 	{
-	    const Action::Base* action = graph[vertex].get();
+	    const unsigned int max_parallel_actions = storage.get_max_parallel_actions();
+
+	    if (max_parallel_actions > 1)
+		commit_parallel(commit_data, commit_options, max_parallel_actions, commit_callbacks);
+	    else
+		commit_serial(commit_data, commit_options, commit_callbacks);
+	}
+	catch (...)
+	{
+	    // Do not leave partitions created together with the partition of
+	    // an earlier action unfinished, e.g. if the commit was aborted.
+
+	    finish_coalesced_partitions(commit_data);
+
+	    // Do not lose the modifications of the config files done so far,
+	    // e.g. if the commit was aborted. An error while writing them is
+	    // only logged so that the original exception is rethrown.
+
+	    try
+	    {
+		commit_data.flush();
+	    }
+	    catch (const Exception& exception)
+	    {
+		ST_CAUGHT(exception);
+	    }
+	    catch (...)
+	    {
+		y2err("writing configuration files failed");
+	    }
+
+	    throw;
+	}
+
+	flush_config_files(commit_data, commit_callbacks);
+
+	y2mil("commit end");
+    }
+
+
+    void
+    Actiongraph::Impl::commit_serial(CommitData& commit_data, const CommitOptions& commit_options,
+				     const CommitCallbacks* commit_callbacks) const
+    {
+	const bool coalesce = storage.get_coalesce_partition_actions();
+
+	for (size_t position = 0; position < order.size(); ++position)
+	{
+	    const Action::Base* action = graph[order[position]].get();
 
 	    ActionCallbacksGuard action_callbacks_guard(commit_callbacks, action);
 
@@ -940,6 +1212,12 @@ namespace storage
 
 	    try
 	    {
+		if (needs_config_files(action))
+		    commit_data.flush();
+
+		if (coalesce)
+		    coalesce_partition_actions(commit_data, position);
+
 		action->commit(commit_data, commit_options);
 	    }
 	    catch (const Exception& exception)
@@ -949,8 +1227,383 @@ namespace storage
 		error_callback(commit_callbacks, text, exception);
 	    }
 	}
+    }
 
-	y2mil("commit end");
+
+    void
+    Actiongraph::Impl::coalesce_partition_actions(CommitData& commit_data, size_t position) const
+    {
+	const Action::Base* action = graph[order[position]].get();
+
+	if (!action->affects_device() || contains(commit_data.coalesced_sids, action->sid) ||
+	    contains(commit_data.failed_coalesced_sids, action->sid))
+	    return;
+
+	const bool create = is_create(action);
+	if (!create && !is_delete(action))
+	    return;
+
+	const Device* device = find_device(action->sid, create ? RHS : LHS);
+	if (!is_partition(device))
+	    return;
+
+	const PartitionTable* partition_table = to_partition(device)->get_partition_table();
+	if (!is_gpt(partition_table) && !is_msdos(partition_table))
+	    return;
+
+	// Returns the partition if the action creates resp. deletes a
+	// partition on the partition table that can be coalesced.
+
+	auto coalescable = [&](const Action::Base* tmp_action) -> const Partition* {
+
+	    if (!tmp_action->affects_device() || !(create ? is_create(tmp_action) : is_delete(tmp_action)))
+		return nullptr;
+
+	    const Device* tmp_device = find_device(tmp_action->sid, create ? RHS : LHS);
+	    if (!is_partition(tmp_device))
+		return nullptr;
+
+	    const Partition* tmp_partition = to_partition(tmp_device);
+	    if (tmp_partition->get_partition_table() != partition_table)
+		return nullptr;
+
+	    if (create && !tmp_partition->get_impl().can_create_coalesced())
+		return nullptr;
+
+	    return tmp_partition;
+	};
+
+	// Only directly following actions are taken, ignoring actions doing
+	// nothing. So the dependencies of all taken actions are fulfilled and
+	// the partition numbers are the same as with one parted call per
+	// action, also for logical partitions.
+
+	vector<const Partition*> partitions;
+
+	for (size_t tmp_position = position; tmp_position < order.size(); ++tmp_position)
+	{
+	    const Action::Base* tmp_action = graph[order[tmp_position]].get();
+	    if (tmp_action->nop)
+		continue;
+
+	    const Partition* partition = coalescable(tmp_action);
+	    if (!partition)
+		break;
+
+	    partitions.push_back(partition);
+	}
+
+	if (partitions.size() < 2)
+	    return;
+
+	y2mil("coalescing " << (create ? "create" : "delete") << " of " << partitions.size() <<
+	      " partitions on " << partition_table->get_partitionable()->get_name());
+
+	try
+	{
+	    if (create)
+		Partition::Impl::do_create_coalesced(partitions);
+	    else
+		Partition::Impl::do_delete_coalesced(partitions);
+	}
+	catch (const Exception& exception)
+	{
+	    // The error is reported for the current action. The actions of
+	    // the other partitions fail when they are committed.
+
+	    for (const Partition* tmp : partitions)
+		commit_data.failed_coalesced_sids.insert(tmp->get_sid());
+
+	    ST_RETHROW(exception);
+	}
+
+	for (const Partition* tmp : partitions)
+	    commit_data.coalesced_sids.insert(tmp->get_sid());
+    }
+
+
+    void
+    Actiongraph::Impl::finish_coalesced_partitions(CommitData& commit_data) const
+    {
+	for (sid_t sid : commit_data.coalesced_sids)
+	{
+	    // Deleted partitions need no further work.
+
+	    if (lhs->device_exists(sid))
+		continue;
+
+	    try
+	    {
+		to_partition(rhs->find_device(sid))->get_impl().do_create_coalesced_finish();
+	    }
+	    catch (const Exception& exception)
+	    {
+		ST_CAUGHT(exception);
+	    }
+	}
+
+	commit_data.coalesced_sids.clear();
+    }
+
+
+    namespace
+    {
+
+	/**
+	 * Whether the action can run in parallel to other actions. Mount and
+	 * unmount actions and actions on /etc/fstab and similar files use
+	 * common resources and must run alone.
+	 */
+	bool
+	is_parallelizable(const Action::Base* action)
+	{
+	    if (action->nop || is_mount(action) || is_unmount(action))
+		return false;
+
+	    return is_create(action) || is_delete(action) || is_action_of_type<const Action::Resize>(action);
+	}
+
+    }
+
+
+    set<sid_t>
+    Actiongraph::Impl::get_roots(const Action::Base* action) const
+    {
+	set<sid_t> ret;
+
+	auto add_roots = [this, &ret](sid_t sid) {
+	    const Devicegraph* devicegraph = rhs->device_exists(sid) ? rhs : lhs;
+	    for (const Device* root : devicegraph->find_device(sid)->get_roots(true))
+		ret.insert(root->get_sid());
+	};
+
+	if (action->affects_device())
+	{
+	    add_roots(action->sid);
+	}
+	else
+	{
+	    add_roots(action->sid_pair.first);
+	    add_roots(action->sid_pair.second);
+	}
+
+	return ret;
+    }
+
+
+    void
+    Actiongraph::Impl::commit_parallel(CommitData& commit_data, const CommitOptions& commit_options,
+				       unsigned int max_parallel_actions,
+				       const CommitCallbacks* commit_callbacks) const
+    {
+	// Based on Kahn's algorithm. Ready actions are started in the order
+	// of the serial commit unless they affect the same device trees as a
+	// running action. An action that cannot run in parallel waits for
+	// all running actions and blocks the start of further actions. Only
+	// Action::Base::commit() runs in the worker threads, everything else
+	// including the callbacks happens in this thread.
+
+	lhs->get_impl().materialize_all();
+	rhs->get_impl().materialize_all();
+
+	const auto idx = boost::get(boost::vertex_index, graph);
+
+	vector<size_t> positions(num_actions());
+	for (size_t position = 0; position < order.size(); ++position)
+	    positions[idx[order[position]]] = position;
+
+	vector<degree_size_type> in_degrees(num_actions());
+	vector<bool> parallelizable(num_actions());
+	vector<set<sid_t>> roots(num_actions());
+
+	// Positions of ready actions.
+	set<size_t> ready;
+
+	for (const vertex_descriptor vertex : vertices())
+	{
+	    const Action::Base* action = graph[vertex].get();
+
+	    parallelizable[idx[vertex]] = is_parallelizable(action);
+	    if (parallelizable[idx[vertex]])
+		roots[idx[vertex]] = get_roots(action);
+
+	    if ((in_degrees[idx[vertex]] = boost::in_degree(vertex, graph)) == 0)
+		ready.insert(positions[idx[vertex]]);
+	}
+
+	auto conflicts = [&](vertex_descriptor vertex, vertex_descriptor running) {
+	    const set<sid_t>& roots1 = roots[idx[vertex]];
+	    const set<sid_t>& roots2 = roots[idx[running]];
+	    return any_of(roots1.begin(), roots1.end(), [&roots2](sid_t sid) { return contains(roots2, sid); });
+	};
+
+	auto finish = [&](vertex_descriptor vertex) {
+	    for (const vertex_descriptor child : children(vertex))
+	    {
+		if (--in_degrees[idx[child]] == 0)
+		    ready.insert(positions[idx[child]]);
+	    }
+	};
+
+	struct Running
+	{
+	    unique_ptr<ActionCallbacksGuard> action_callbacks_guard;
+	    Text text;
+	};
+
+	map<vertex_descriptor, Running> running;
+
+	mutex finished_mutex;
+	condition_variable finished_condition;
+	deque<pair<vertex_descriptor, exception_ptr>> finished;
+
+	// The first exception not handled by the error callback, e.g.
+	// Aborted. No further actions are started and the exception is
+	// rethrown once the running actions are finished.
+	exception_ptr abort;
+
+	WorkerPool worker_pool(max_parallel_actions);
+
+	while (true)
+	{
+	    try
+	    {
+		set<size_t>::iterator it = ready.begin();
+
+		while (!abort && it != ready.end() && running.size() < max_parallel_actions)
+		{
+		    const vertex_descriptor vertex = order[*it];
+		    const Action::Base* action = graph[vertex].get();
+
+		    if (!parallelizable[idx[vertex]])
+		    {
+			if (!running.empty())
+			    break;
+		    }
+		    else
+		    {
+			if (any_of(running.begin(), running.end(), [&](const auto& tmp) {
+			    return !parallelizable[idx[tmp.first]] || conflicts(vertex, tmp.first);
+			}))
+			{
+			    ++it;
+			    continue;
+			}
+		    }
+
+		    ready.erase(it);
+
+		    unique_ptr<ActionCallbacksGuard> action_callbacks_guard =
+			make_unique<ActionCallbacksGuard>(commit_callbacks, action);
+
+		    Text text = action->text(commit_data);
+
+		    y2mil("Commit Action \"" << text.native << "\" [" << action->details() << "]");
+
+		    message_callback(commit_callbacks, text);
+
+		    if (parallelizable[idx[vertex]])
+		    {
+			running.emplace(vertex, Running { std::move(action_callbacks_guard), text });
+
+			worker_pool.submit([&, vertex, action]() {
+			    exception_ptr exception;
+
+			    try
+			    {
+				action->commit(commit_data, commit_options);
+			    }
+			    catch (...)
+			    {
+				exception = current_exception();
+			    }
+
+			    lock_guard<mutex> lock(finished_mutex);
+			    finished.emplace_back(vertex, exception);
+			    finished_condition.notify_one();
+			});
+		    }
+		    else
+		    {
+			if (!action->nop)
+			{
+			    try
+			    {
+				if (needs_config_files(action))
+				    commit_data.flush();
+
+				action->commit(commit_data, commit_options);
+			    }
+			    catch (const Exception& exception)
+			    {
+				ST_CAUGHT(exception);
+
+				error_callback(commit_callbacks, text, exception);
+			    }
+			}
+
+			action_callbacks_guard.reset();
+
+			finish(vertex);
+		    }
+
+		    it = ready.begin();
+		}
+	    }
+	    catch (...)
+	    {
+		abort = current_exception();
+	    }
+
+	    if (running.empty())
+		break;
+
+	    pair<vertex_descriptor, exception_ptr> tmp;
+
+	    {
+		unique_lock<mutex> lock(finished_mutex);
+		finished_condition.wait(lock, [&finished]() { return !finished.empty(); });
+
+		tmp = finished.front();
+		finished.pop_front();
+	    }
+
+	    map<vertex_descriptor, Running>::iterator it = running.find(tmp.first);
+
+	    if (tmp.second)
+	    {
+		try
+		{
+		    rethrow_exception(tmp.second);
+		}
+		catch (const Exception& exception)
+		{
+		    ST_CAUGHT(exception);
+
+		    try
+		    {
+			error_callback(commit_callbacks, it->second.text, exception);
+		    }
+		    catch (...)
+		    {
+			if (!abort)
+			    abort = current_exception();
+		    }
+		}
+		catch (...)
+		{
+		    if (!abort)
+			abort = current_exception();
+		}
+	    }
+
+	    running.erase(it);
+
+	    finish(tmp.first);
+	}
+
+	if (abort)
+	    rethrow_exception(abort);
     }
 
 
@@ -1035,13 +1688,11 @@ namespace storage
 
 	fout << "// " << generated_string() << "\n\n";
 
-	VertexIndexMapGenerator<graph_t> vertex_index_map_generator(graph);
-
 	const CommitData commit_data(*this, Tense::SIMPLE_PRESENT);
 
 	const ActiongraphWriter actiongraph_writer(style_callbacks, commit_data);
 	boost::write_graphviz(fout, graph, actiongraph_writer, actiongraph_writer, actiongraph_writer,
-			      vertex_index_map_generator.get());
+			      boost::get(boost::vertex_index, graph));
 
 	fout.close();
 
@@ -82,12 +82,45 @@ namespace storage
 	EtcCrypttab& get_etc_crypttab();
 	EtcMdadm& get_etc_mdadm();
 
+	/**
+	 * Mark the config file as modified. The modifications are only
+	 * written to disk by flush().
+	 */
+	void set_etc_fstab_dirty() { etc_fstab_dirty = true; }
+	void set_etc_crypttab_dirty() { etc_crypttab_dirty = true; }
+	void set_etc_mdadm_dirty() { etc_mdadm_dirty = true; }
+
+	/**
+	 * Write all modified config files. Called before actions that may
+	 * need the config files on disk and at the end of the commit, so
+	 * that every config file is written only once in between even if
+	 * many actions modify it.
+	 */
+	void flush();
+
+	/**
+	 * Sids of partitions already created resp. deleted together with
+	 * other partitions, see Actiongraph::Impl::coalesce_partition_actions(),
+	 * whose actions are not yet committed.
+	 */
+	set<sid_t> coalesced_sids;
+
+	/**
+	 * Sids of partitions for which creating resp. deleting together with
+	 * other partitions failed.
+	 */
+	set<sid_t> failed_coalesced_sids;
+
     private:
 
 	std::unique_ptr<EtcFstab> etc_fstab;
 	std::unique_ptr<EtcCrypttab> etc_crypttab;
 	std::unique_ptr<EtcMdadm> etc_mdadm;
 
+	bool etc_fstab_dirty = false;
+	bool etc_crypttab_dirty = false;
+	bool etc_mdadm_dirty = false;
+
     };
 
 
@@ -96,8 +129,14 @@ namespace storage
 
     private:
 
+	// Every vertex has a dense index in [0, num_actions()) as internal
+	// vertex_index property used by the BGL algorithms, see add_vertex()
+	// and remove_vertex().
+
+	typedef boost::property<boost::vertex_index_t, size_t, std::shared_ptr<Action::Base>> vertex_property_t;
+
 	typedef boost::adjacency_list<boost::vecS, boost::listS, boost::bidirectionalS,
-				      std::shared_ptr<Action::Base>> graph_t;
+				      vertex_property_t> graph_t;
 
     public:
 
@@ -113,8 +152,6 @@ namespace storage
 	typedef graph_t::vertices_size_type vertices_size_type;
 	typedef graph_t::degree_size_type degree_size_type;
 
-	typedef map<vertex_descriptor, vertices_size_type> vertex_index_map_t;
-
 	Impl(const Storage& storage, Devicegraph* lhs, Devicegraph* rhs);
 
 	const Storage& get_storage() const { return storage; }
@@ -198,6 +235,14 @@ namespace storage
 	void set_special_flags();
 	void get_device_actions();
 	void get_holder_actions();
+
+	/**
+	 * Returns the sids of all devices existing in both devicegraphs that
+	 * might need modify actions. See get_device_actions().
+	 */
+	set<sid_t> get_affected_sids(const vector<sid_t>& created_sids, const vector<sid_t>& common_sids,
+				     const vector<sid_t>& deleted_sids) const;
+
 	void remove_duplicates();
 	void set_special_actions();
 	void add_dependencies();
@@ -209,6 +254,49 @@ namespace storage
 	void calculate_order();
 	void check_taboos();
 
+	/**
+	 * Removes the vertex and all its edges. The last vertex takes over the
+	 * vertex index of the removed vertex.
+	 */
+	void remove_vertex(vertex_descriptor vertex);
+
+	/**
+	 * Commit with one action after the other in the order.
+	 */
+	void commit_serial(CommitData& commit_data, const CommitOptions& commit_options,
+			   const CommitCallbacks* commit_callbacks) const;
+
+	/**
+	 * Commit with up to max_parallel_actions actions running in
+	 * parallel, see Storage::set_max_parallel_actions().
+	 */
+	void commit_parallel(CommitData& commit_data, const CommitOptions& commit_options,
+			     unsigned int max_parallel_actions,
+			     const CommitCallbacks* commit_callbacks) const;
+
+	/**
+	 * If the action at position in order creates resp. deletes a
+	 * partition, creates resp. deletes it together with the partitions
+	 * of the directly following create resp. delete actions on the same
+	 * partition table. So creating many partitions needs only one parted
+	 * call and one re-read of the partition table by the kernel, see
+	 * Storage::set_coalesce_partition_actions().
+	 */
+	void coalesce_partition_actions(CommitData& commit_data, size_t position) const;
+
+	/**
+	 * Finishes the partitions created together with other partitions
+	 * whose create actions were not committed, e.g. since the commit was
+	 * aborted. Errors are only logged.
+	 */
+	void finish_coalesced_partitions(CommitData& commit_data) const;
+
+	/**
+	 * Returns the sids of the roots of the devices affected by the
+	 * action. Actions with disjoint roots can run in parallel.
+	 */
+	set<sid_t> get_roots(const Action::Base* action) const;
+
 	const Storage& storage;
 
 	Devicegraph* lhs;
@@ -218,12 +306,13 @@ namespace storage
 
 	Order order;
 
-	class CompareByPriority;
-
-	Order prioritised_topological_sort(const boost::associative_property_map<vertex_index_map_t>& idx) const;
+	Order prioritised_topological_sort() const;
 
 	graph_t graph;
 
+	// the vertices by their vertex index
+	vector<vertex_descriptor> vertices_by_index;
+
 	// map from path to mount/unmount action
 	using mount_map_t = map<string, vertex_descriptor>;
 
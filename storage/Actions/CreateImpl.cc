@@ -24,6 +24,8 @@
 #include "storage/Actions/CreateImpl.h"
 #include "storage/Actions/Delete.h"
 #include "storage/Devices/DeviceImpl.h"
+#include "storage/Devices/PartitionImpl.h"
+#include "storage/Utils/StorageTmpl.h"
 
 
 namespace storage
@@ -57,7 +59,19 @@ namespace storage
 		{
 		    Device* device = get_device(commit_data.actiongraph);
 
-		    device->get_impl().do_create();
+		    if (contains(commit_data.failed_coalesced_sids, sid))
+			ST_THROW(Exception("creating partition together with other partitions failed"));
+
+		    if (contains(commit_data.coalesced_sids, sid))
+		    {
+			commit_data.coalesced_sids.erase(sid);
+			to_partition(device)->get_impl().do_create_coalesced_finish();
+		    }
+		    else
+		    {
+			device->get_impl().do_create();
+		    }
+
 		    device->get_impl().do_create_post_verify();
 		}
 		break;
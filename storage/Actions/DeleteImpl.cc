@@ -23,6 +23,7 @@
 
 #include "storage/Actions/DeleteImpl.h"
 #include "storage/Devices/DeviceImpl.h"
+#include "storage/Utils/StorageTmpl.h"
 
 
 namespace storage
@@ -53,7 +54,13 @@ namespace storage
 	    switch (affect)
 	    {
 		case Affect::DEVICE:
-		    get_device(commit_data.actiongraph)->get_impl().do_delete();
+		    if (contains(commit_data.failed_coalesced_sids, sid))
+			ST_THROW(Exception("deleting partition together with other partitions failed"));
+
+		    if (contains(commit_data.coalesced_sids, sid))
+			commit_data.coalesced_sids.erase(sid);
+		    else
+			get_device(commit_data.actiongraph)->get_impl().do_delete();
 		    break;
 
 		case Affect::HOLDER:
@@ -21,6 +21,7 @@
  */
 
 
+#include <exception>
 #include <boost/graph/copy.hpp>
 #include <boost/graph/reverse_graph.hpp>
 #include <boost/graph/graphviz.hpp>
@@ -167,6 +168,13 @@ namespace storage
     }
 
 
+    void
+    Devicegraph::load(const string& filename, bool keep_sids, bool lazy)
+    {
+	get_impl().load(this, filename, keep_sids, lazy);
+    }
+
+
     void
     Devicegraph::save(const string& filename) const
     {
@@ -355,17 +363,28 @@ namespace storage
     {
 	get_impl().remove_vertex(device->get_impl().get_vertex());
         // ensure that bcache numbers are correct
-	Bcache::reassign_numbers(this);
+	if (get_impl().in_batch())
+	    get_impl().bcache_numbers_outdated = true;
+	else
+	    Bcache::reassign_numbers(this);
     }
 
 
     void
     Devicegraph::remove_devices(std::vector<Device*> devices)
     {
+	vector<Impl::vertex_descriptor> vertices;
+	vertices.reserve(devices.size());
+
 	for (Device* device : devices)
-	    get_impl().remove_vertex(device->get_impl().get_vertex());
+	    vertices.push_back(device->get_impl().get_vertex());
+
+	get_impl().remove_vertices(vertices);
 	// ensure that bcache numbers are correct
-	Bcache::reassign_numbers(this);
+	if (get_impl().in_batch())
+	    get_impl().bcache_numbers_outdated = true;
+	else
+	    Bcache::reassign_numbers(this);
     }
 
 
@@ -383,6 +402,65 @@ namespace storage
     }
 
 
+    Devicegraph::Batch::Batch(Devicegraph* devicegraph)
+	: devicegraph(devicegraph), uncaught_exceptions(std::uncaught_exceptions())
+    {
+	devicegraph->get_impl().begin_batch();
+    }
+
+
+    Devicegraph::Batch::~Batch()
+    {
+	if (ended)
+	    return;
+
+	// The destructor must not throw. If the batch is left due to an
+	// exception the deferred work is skipped.
+
+	try
+	{
+	    end(std::uncaught_exceptions() == uncaught_exceptions);
+	}
+	catch (const Exception& exception)
+	{
+	    ST_CAUGHT(exception);
+
+	    y2err("ending batch failed");
+	}
+	catch (const std::exception& exception)
+	{
+	    y2err("ending batch failed: " << exception.what());
+	}
+    }
+
+
+    void
+    Devicegraph::Batch::commit()
+    {
+	if (ended)
+	    ST_THROW(LogicException("batch already ended"));
+
+	end(true);
+
+	devicegraph->check();
+    }
+
+
+    void
+    Devicegraph::Batch::end(bool apply)
+    {
+	ended = true;
+
+	Impl& impl = devicegraph->get_impl();
+
+	if (impl.end_batch(apply) && apply && impl.bcache_numbers_outdated)
+	{
+	    impl.bcache_numbers_outdated = false;
+	    Bcache::reassign_numbers(devicegraph);
+	}
+    }
+
+
     uint64_t
     Devicegraph::used_features() const
     {
@@ -204,6 +204,16 @@ namespace storage
 	 */
 	void load(const std::string& filename, bool keep_sids);
 
+	/**
+	 * Load the devicegraph from a file. With lazy and keep_sids the devices
+	 * and holders are only created when they are accessed. Finding a device
+	 * by sid creates only the devices connected to it while functions working
+	 * on all devices create all of them.
+	 *
+	 * @throw Exception
+	 */
+	void load(const std::string& filename, bool keep_sids, bool lazy);
+
 	/**
 	 * Save the devicegraph to a file.
 	 *
@@ -389,6 +399,53 @@ namespace storage
 	 */
 	void check(const CheckCallbacks* check_callbacks = nullptr) const;
 
+	/**
+	 * Scope object for many changes of a devicegraph, e.g. creating or
+	 * removing thousands of devices. Until the batch ends some index
+	 * maintenance and the renumbering of bcache devices after removals
+	 * are deferred. Batches can be nested, the outermost batch applies
+	 * the deferred work.
+	 *
+	 * \code
+	 * {
+	 *     Devicegraph::Batch batch(devicegraph);
+	 *     ...
+	 *     batch.commit();
+	 * }
+	 * \endcode
+	 */
+	class Batch : private boost::noncopyable
+	{
+	public:
+
+	    Batch(Devicegraph* devicegraph);
+
+	    /**
+	     * Ends the batch if commit() was not called. Errors are only
+	     * logged. If the batch is left due to an exception the deferred
+	     * renumbering of bcache devices is skipped.
+	     */
+	    ~Batch();
+
+	    /**
+	     * Ends the batch and checks the devicegraph. Afterwards the
+	     * batch has no effect.
+	     *
+	     * @throw Exception
+	     */
+	    void commit();
+
+	private:
+
+	    void end(bool apply);
+
+	    Devicegraph* devicegraph;
+	    bool ended = false;
+
+	    const int uncaught_exceptions;
+
+	};
+
 	uint64_t used_features() const ST_DEPRECATED;
 
 	/**
@@ -21,21 +21,24 @@
  */
 
 
+#include <cstring>
 #include <boost/graph/copy.hpp>
 #include <boost/graph/reverse_graph.hpp>
 #include <boost/graph/graphviz.hpp>
 #include <boost/graph/graph_utility.hpp>
+#include <boost/range/distance.hpp>
 
 #include "storage/DevicegraphImpl.h"
 #include "storage/Utils/GraphUtils.h"
 #include "storage/Utils/XmlFile.h"
 #include "storage/Devices/DeviceImpl.h"
-#include "storage/Devices/Disk.h"
-#include "storage/Filesystems/Nfs.h"
-#include "storage/Filesystems/Tmpfs.h"
-#include "storage/Filesystems/MountPoint.h"
+#include "storage/Devices/DiskImpl.h"
+#include "storage/Filesystems/NfsImpl.h"
+#include "storage/Filesystems/TmpfsImpl.h"
+#include "storage/Filesystems/MountPointImpl.h"
 #include "storage/Holders/Holder.h"
 #include "storage/StorageImpl.h"
+#include "storage/EnvironmentImpl.h"
 #include "storage/Utils/Format.h"
 #include "storage/Utils/LoggerImpl.h"
 #include "storage/GraphvizImpl.h"
@@ -45,9 +48,73 @@
 namespace storage
 {
 
+    struct Devicegraph::Impl::LazyState
+    {
+	LazyState(Devicegraph* devicegraph) : devicegraph(devicegraph) {}
+	~LazyState();
+
+	Devicegraph* devicegraph;
+
+	// Copies of the XML nodes of the devices and holders in the order of
+	// the file. Freed once the device or holder is created.
+	vector<xmlNode*> device_nodes;
+	vector<xmlNode*> holder_nodes;
+
+	// Connected component of each device.
+	std::unordered_map<sid_t, size_t> components_by_sid;
+
+	// Indexes of the device and holder records of each component.
+	vector<vector<uint32_t>> device_records;
+	vector<vector<uint32_t>> holder_records;
+
+	vector<bool> materialized;
+	size_t num_materialized = 0;
+
+	size_t num_unmaterialized_devices = 0;
+	size_t num_unmaterialized_holders = 0;
+
+	// Set while a component is created to ignore nested calls.
+	bool materializing = false;
+    };
+
+
+    Devicegraph::Impl::LazyState::~LazyState()
+    {
+	for (xmlNode* node : device_nodes)
+	    xmlFreeNode(node);
+
+	for (xmlNode* node : holder_nodes)
+	    xmlFreeNode(node);
+    }
+
+
+    Devicegraph::Impl::Impl(Storage* storage)
+	: storage(storage)
+    {
+    }
+
+
+    Devicegraph::Impl::~Impl() = default;
+
+
     bool
     Devicegraph::Impl::operator==(const Impl& rhs) const
     {
+	if (num_devices() != rhs.num_devices() || num_holders() != rhs.num_holders())
+	    return false;
+
+	// Different content hashes imply different devicegraphs. Equal content
+	// hashes still need the full comparison below.
+	//
+	// In developer mode the shortcut is skipped and the full comparison
+	// verifies that no cached content hash is outdated, e.g. by a setter
+	// of a hashed member not calling content_changed().
+
+	const bool verify = developer_mode();
+
+	if (!verify && get_content_hash() != rhs.get_content_hash())
+	    return false;
+
 	const set<sid_t> lhs_device_sids = get_device_sids();
 	const set<sid_t> rhs_device_sids = rhs.get_device_sids();
 
@@ -81,6 +148,9 @@ namespace storage
 		return false;
 	}
 
+	if (verify && get_content_hash() != rhs.get_content_hash())
+	    ST_THROW(LogicException("equal devicegraphs have different content hashes"));
+
 	return true;
     }
 
@@ -104,10 +174,13 @@ namespace storage
 	    if (*graph[lhs_vertex].get() != *rhs.graph[rhs_vertex].get())
 		log << "sid " << sid << " device differ\n";
 
-	    if (graph[lhs_vertex]->get_impl().get_classname() != graph[rhs_vertex]->get_impl().get_classname())
+	    const Device* lhs_device = (*this)[lhs_vertex];
+	    const Device* rhs_device = rhs[rhs_vertex];
+
+	    if (lhs_device->get_impl().get_classname() != rhs_device->get_impl().get_classname())
 		log << "devices with sid " << sid << " have different types\n";
 	    else
-		graph[lhs_vertex]->get_impl().log_diff(log, rhs.graph[rhs_vertex]->get_impl());
+		lhs_device->get_impl().log_diff(log, rhs_device->get_impl());
 	}
 
 	const set<sid_pair_t> lhs_holder_sids = get_holder_sid_pairs();
@@ -178,17 +251,25 @@ namespace storage
 	    void operator()(const Devicegraph::Impl::vertex_descriptor& v_in,
 			    Devicegraph::Impl::vertex_descriptor& v_out)
 	    {
-		shared_ptr<Device> device = g_in.graph[v_in]->clone_v2();
-		g_out.get_impl().graph[v_out] = device;
-		device->get_impl().set_devicegraph_and_vertex(&g_out, v_out);
+		unique_ptr<Device> device = g_in.graph[v_in]->clone_v2();
+
+		Device::Impl& impl = device->get_impl();
+		impl.copy_content_state(g_in[v_in]->get_impl());
+
+		g_out.get_impl().graph[v_out] = to_pooled(std::move(device));
+		impl.set_devicegraph_and_vertex(&g_out, v_out);
 	    }
 
 	    void operator()(const Devicegraph::Impl::edge_descriptor& e_in,
 			    Devicegraph::Impl::edge_descriptor& e_out)
 	    {
-		shared_ptr<Holder> holder = g_in.graph[e_in]->clone_v2();
-		g_out.get_impl().graph[e_out] = holder;
-		holder->get_impl().set_devicegraph_and_edge(&g_out, e_out);
+		unique_ptr<Holder> holder = g_in.graph[e_in]->clone_v2();
+
+		Holder::Impl& impl = holder->get_impl();
+		impl.copy_content_state(g_in[e_in]->get_impl());
+
+		g_out.get_impl().graph[e_out] = to_pooled(std::move(holder));
+		impl.set_devicegraph_and_edge(&g_out, e_out);
 	    }
 
 	private:
@@ -204,21 +285,86 @@ namespace storage
     void
     Devicegraph::Impl::copy(Devicegraph& dest) const
     {
-	dest.get_impl().clear();
+	StatisticsStopwatch stopwatch(Statistics::Counter::COPY);
+
+	materialize_all();
 
-	VertexIndexMapGenerator<graph_t> vertex_index_map_generator(graph);
+	Impl& dest_impl = dest.get_impl();
+
+	dest_impl.clear();
 
 	CloneCopier copier(*this, dest);
 
-	boost::copy_graph(graph, dest.get_impl().graph,
-			  vertex_index_map(vertex_index_map_generator.get()).
-			  vertex_copy(copier).edge_copy(copier));
+	// Since the vertex indexes are dense a vector is enough to map the
+	// vertices of this devicegraph to the vertices of the copy.
+
+	vector<vertex_descriptor> orig_to_copy(num_devices());
+
+	boost::copy_graph(graph, dest_impl.graph, boost::vertex_copy(copier).edge_copy(copier).
+			  orig_to_copy(boost::make_iterator_property_map(orig_to_copy.begin(),
+									 boost::get(boost::vertex_index, graph))));
+
+	dest_impl.copy_indexes(*this, orig_to_copy);
+    }
+
+
+    namespace
+    {
+
+	/**
+	 * Forwards errors to the check callbacks, if any, and records
+	 * whether errors were reported.
+	 */
+	class RecordingCheckCallbacks : public CheckCallbacks
+	{
+	public:
+
+	    RecordingCheckCallbacks(const CheckCallbacks* check_callbacks)
+		: check_callbacks(check_callbacks) {}
+
+	    virtual void error(const string& message) const override
+	    {
+		has_error = true;
+
+		if (check_callbacks)
+		    check_callbacks->error(message);
+	    }
+
+	    mutable bool has_error = false;
+
+	private:
+
+	    const CheckCallbacks* check_callbacks;
+
+	};
+
     }
 
 
     void
     Devicegraph::Impl::check(const CheckCallbacks* check_callbacks) const
     {
+	std::lock_guard<std::mutex> lock(check_mutex);
+
+	// With duplicate sids the sid index has less entries than there are
+	// vertices. Let the full check report that.
+
+	if (check_valid && sid_index.size() == num_devices() && (!check_callbacks || check_errors_known))
+	    incremental_check(check_callbacks);
+	else
+	    full_check(check_callbacks);
+    }
+
+
+    void
+    Devicegraph::Impl::full_check(const CheckCallbacks* check_callbacks) const
+    {
+	// The sids of all devices and holders are also needed to make the
+	// copies for the next check.
+
+	set<sid_t> sids;
+	set<sid_pair_t> sid_pairs;
+
 	{
 	    // check uniqueness of device and holder object and sid
 
@@ -226,7 +372,6 @@ namespace storage
 
 	    set<const Device*> devices;
 	    set<const Holder*> holders;
-	    set<sid_t> sids;
 
 	    for (vertex_descriptor vertex : vertices())
 	    {
@@ -259,6 +404,8 @@ namespace storage
 		if (!holders.insert(holder).second)
 		    ST_THROW(LogicException("holder object not unique within graph"));
 
+		sid_pairs.emplace(holder->get_source_sid(), holder->get_target_sid());
+
 		// check holder back reference
 
 		if (&holder->get_devicegraph()->get_impl() != this)
@@ -275,29 +422,264 @@ namespace storage
 	    filtered_graph_t filtered_graph(graph, make_edge_filter(View::CLASSIC),
 					    make_vertex_filter(View::CLASSIC));
 
-	    VertexIndexMapGenerator<filtered_graph_t> vertex_index_map_generator(filtered_graph);
-
 	    bool has_cycle = false;
 
 	    CycleDetector cycle_detector(has_cycle);
-	    boost::depth_first_search(filtered_graph, visitor(cycle_detector).
-				      vertex_index_map(vertex_index_map_generator.get()));
+	    boost::depth_first_search(filtered_graph, visitor(cycle_detector));
 
 	    if (has_cycle)
 		ST_THROW(Exception("devicegraph has a cycle"));
 	}
 
+	std::unordered_set<sid_t> tmp_sids_with_check_errors;
+
 	{
 	    for (vertex_descriptor vertex : vertices())
 	    {
 		const Device* device = graph[vertex].get();
-		device->get_impl().check(check_callbacks);
+
+		// Some device checks are only done with check callbacks.
+
+		RecordingCheckCallbacks recording_check_callbacks(check_callbacks);
+		device->get_impl().check(check_callbacks ? &recording_check_callbacks : nullptr);
+
+		if (recording_check_callbacks.has_error)
+		    tmp_sids_with_check_errors.insert(device->get_sid());
 	    }
 	}
 
 	// TODO check that out-edges are consistent, e.g. of same type, only one per Subdevice
 	// TODO check that in-edges are consistent, e.g. of same type, exactly one for Partition
 	// in general subcheck for each device
+
+	checked_devices.clear();
+	checked_holders.clear();
+
+	update_checked(sids, sid_pairs);
+
+	check_valid = true;
+	check_errors_known = check_callbacks != nullptr;
+	unchecked_sids.clear();
+	unchecked_sid_pairs.clear();
+	sids_with_check_errors.swap(tmp_sids_with_check_errors);
+    }
+
+
+    void
+    Devicegraph::Impl::incremental_check(const CheckCallbacks* check_callbacks) const
+    {
+	// Collect the vertices to check: the devices changed since the last
+	// check, the devices affected by changes of the structure, the
+	// devices that reported errors last time and all their ancestors and
+	// descendants since device checks also look at related devices,
+	// e.g. a volume group at its logical volumes. Sids of meanwhile
+	// removed devices are skipped.
+
+	set<sid_t> changed_sids(unchecked_sids.begin(), unchecked_sids.end());
+	set<sid_pair_t> changed_sid_pairs(unchecked_sid_pairs.begin(), unchecked_sid_pairs.end());
+
+	find_changed_since_check(changed_sids, changed_sid_pairs);
+
+	set<vertex_descriptor> vertices_to_check;
+
+	auto insert_sid = [this, &vertices_to_check](sid_t sid) {
+	    sid_index_t::const_iterator it = sid_index.find(sid);
+	    if (it == sid_index.end())
+		return;
+
+	    if (!vertices_to_check.insert(it->second).second)
+		return;
+
+	    for (vertex_descriptor tmp : ancestors(it->second, false, View::ALL))
+		vertices_to_check.insert(tmp);
+
+	    for (vertex_descriptor tmp : descendants(it->second, false, View::ALL))
+		vertices_to_check.insert(tmp);
+	};
+
+	for (sid_t sid : changed_sids)
+	    insert_sid(sid);
+
+	for (sid_t sid : sids_with_check_errors)
+	    insert_sid(sid);
+
+	{
+	    // check device and holder back reference, with unique objects the
+	    // back references cannot match for more than one vertex or edge
+
+	    for (vertex_descriptor vertex : vertices_to_check)
+	    {
+		const Device* device = graph[vertex].get();
+
+		if (&device->get_devicegraph()->get_impl() != this)
+		    ST_THROW(LogicException("wrong graph in back references"));
+
+		if (device->get_impl().get_vertex() != vertex)
+		    ST_THROW(LogicException("wrong vertex in back references"));
+
+		for (edge_descriptor edge : boost::make_iterator_range(boost::out_edges(vertex, graph)))
+		{
+		    const Holder* holder = graph[edge].get();
+
+		    if (&holder->get_devicegraph()->get_impl() != this)
+			ST_THROW(LogicException("wrong graph in back references"));
+
+		    if (holder->get_impl().get_edge() != edge)
+			ST_THROW(LogicException("wrong edge in back references"));
+		}
+	    }
+	}
+
+	{
+	    // Look for cycles in the classic view. Only new edges can close a
+	    // cycle and that is the case if the source of the edge is a
+	    // descendant of its target.
+
+	    for (const sid_pair_t& sid_pair : unchecked_sid_pairs)
+	    {
+		for (edge_descriptor edge : find_edges(sid_pair.first, sid_pair.second))
+		{
+		    if (!out_edge_in_view_t { &graph, View::CLASSIC }(edge) ||
+			!graph[source(edge)]->get_impl().is_in_view(View::CLASSIC))
+			continue;
+
+		    const vector<vertex_descriptor> tmp = descendants(target(edge), true, View::CLASSIC);
+		    if (find(tmp.begin(), tmp.end(), source(edge)) != tmp.end())
+			ST_THROW(Exception("devicegraph has a cycle"));
+		}
+	    }
+	}
+
+	// All existing devices that reported errors are among the checked
+	// vertices so the set can be built from scratch.
+
+	std::unordered_set<sid_t> tmp_sids_with_check_errors;
+
+	{
+	    for (vertex_descriptor vertex : vertices_to_check)
+	    {
+		const Device* device = graph[vertex].get();
+
+		RecordingCheckCallbacks recording_check_callbacks(check_callbacks);
+		device->get_impl().check(check_callbacks ? &recording_check_callbacks : nullptr);
+
+		if (recording_check_callbacks.has_error)
+		    tmp_sids_with_check_errors.insert(device->get_sid());
+	    }
+	}
+
+	update_checked(changed_sids, changed_sid_pairs);
+
+	unchecked_sids.clear();
+	unchecked_sid_pairs.clear();
+
+	if (check_callbacks)
+	    sids_with_check_errors.swap(tmp_sids_with_check_errors);
+    }
+
+
+    void
+    Devicegraph::Impl::mark_unchecked(sid_t sid) const
+    {
+	if (check_valid)
+	    unchecked_sids.insert(sid);
+    }
+
+
+    void
+    Devicegraph::Impl::find_changed_since_check(set<sid_t>& sids, set<sid_pair_t>& sid_pairs) const
+    {
+	for (vertex_descriptor vertex : vertices())
+	{
+	    const Device* device = graph[vertex].get();
+
+	    map<sid_t, shared_ptr<const Device>>::const_iterator it = checked_devices.find(device->get_sid());
+	    if (it == checked_devices.end() || *it->second != *device)
+		sids.insert(device->get_sid());
+	}
+
+	for (const map<sid_t, shared_ptr<const Device>>::value_type& value : checked_devices)
+	{
+	    if (sid_index.find(value.first) == sid_index.end())
+		sids.insert(value.first);
+	}
+
+	// Parallel holders are compared like in operator==().
+
+	map<sid_pair_t, vector<const Holder*>> holders;
+
+	for (edge_descriptor edge : edges())
+	{
+	    const Holder* holder = graph[edge].get();
+	    holders[make_pair(holder->get_source_sid(), holder->get_target_sid())].push_back(holder);
+	}
+
+	for (const map<sid_pair_t, vector<const Holder*>>::value_type& value : holders)
+	{
+	    map<sid_pair_t, vector<shared_ptr<const Holder>>>::const_iterator it = checked_holders.find(value.first);
+	    if (it == checked_holders.end())
+	    {
+		sid_pairs.insert(value.first);
+		continue;
+	    }
+
+	    vector<const Holder*> tmp;
+	    for (const shared_ptr<const Holder>& holder : it->second)
+		tmp.push_back(holder.get());
+
+	    if (!is_permutation(value.second.begin(), value.second.end(), tmp.begin(), tmp.end(),
+				[](const Holder* lhs, const Holder* rhs) { return *lhs == *rhs; }))
+		sid_pairs.insert(value.first);
+	}
+
+	for (const map<sid_pair_t, vector<shared_ptr<const Holder>>>::value_type& value : checked_holders)
+	{
+	    if (holders.find(value.first) == holders.end())
+		sid_pairs.insert(value.first);
+	}
+
+	for (const sid_pair_t& sid_pair : sid_pairs)
+	{
+	    sids.insert(sid_pair.first);
+	    sids.insert(sid_pair.second);
+	}
+    }
+
+
+    void
+    Devicegraph::Impl::update_checked(const set<sid_t>& sids, const set<sid_pair_t>& sid_pairs) const
+    {
+	for (sid_t sid : sids)
+	{
+	    sid_index_t::const_iterator it = sid_index.find(sid);
+	    if (it != sid_index.end())
+		checked_devices[sid] = graph[it->second]->clone_v2();
+	    else
+		checked_devices.erase(sid);
+	}
+
+	for (const sid_pair_t& sid_pair : sid_pairs)
+	{
+	    vector<shared_ptr<const Holder>> tmp;
+	    for (edge_descriptor edge : find_edges(sid_pair))
+		tmp.push_back(graph[edge]->clone_v2());
+
+	    if (!tmp.empty())
+		checked_holders[sid_pair] = std::move(tmp);
+	    else
+		checked_holders.erase(sid_pair);
+	}
+    }
+
+
+    void
+    Devicegraph::Impl::invalidate_check() const
+    {
+	check_valid = false;
+	unchecked_sids.clear();
+	unchecked_sid_pairs.clear();
+	checked_devices.clear();
+	checked_holders.clear();
     }
 
 
@@ -343,6 +725,9 @@ namespace storage
     bool
     Devicegraph::Impl::empty() const
     {
+	if (lazy_state && lazy_state->num_unmaterialized_devices > 0)
+	    return false;
+
 	return boost::num_vertices(graph) == 0;
     }
 
@@ -350,6 +735,9 @@ namespace storage
     size_t
     Devicegraph::Impl::num_devices() const
     {
+	if (lazy_state)
+	    return boost::num_vertices(graph) + lazy_state->num_unmaterialized_devices;
+
 	return boost::num_vertices(graph);
     }
 
@@ -357,6 +745,9 @@ namespace storage
     size_t
     Devicegraph::Impl::num_holders() const
     {
+	if (lazy_state)
+	    return boost::num_edges(graph) + lazy_state->num_unmaterialized_holders;
+
 	return boost::num_edges(graph);
     }
 
@@ -364,6 +755,8 @@ namespace storage
     boost::iterator_range<Devicegraph::Impl::vertex_iterator>
     Devicegraph::Impl::vertices() const
     {
+	materialize_all();
+
 	return boost::make_iterator_range(boost::vertices(graph));
     }
 
@@ -371,6 +764,8 @@ namespace storage
     boost::iterator_range<Devicegraph::Impl::edge_iterator>
     Devicegraph::Impl::edges() const
     {
+	materialize_all();
+
 	return boost::make_iterator_range(boost::edges(graph));
     }
 
@@ -378,14 +773,29 @@ namespace storage
     Devicegraph::Impl::vertex_descriptor
     Devicegraph::Impl::add_vertex(Device* device)
     {
-	return boost::add_vertex(shared_ptr<Device>(device), graph);
+	return add_vertex_v2(to_pooled(unique_ptr<Device>(device)));
     }
 
 
     Devicegraph::Impl::vertex_descriptor
     Devicegraph::Impl::add_vertex_v2(shared_ptr<Device> device)
     {
-	return boost::add_vertex(device, graph);
+	vertex_descriptor vertex = boost::add_vertex(vertex_property_t(vertices_by_index.size(), device),
+						     graph);
+
+	vertices_by_index.push_back(vertex);
+
+	sid_index.emplace(device->get_sid(), vertex);
+
+	index_vertex_for_lookup(vertex);
+	index_vertex_by_type(vertex);
+
+	content_changed();
+	structure_changed();
+
+	mark_unchecked(device->get_sid());
+
+	return vertex;
     }
 
 
@@ -406,13 +816,24 @@ namespace storage
 	}
 
 	pair<Devicegraph::Impl::edge_descriptor, bool> tmp =
-	    boost::add_edge(source_vertex, target_vertex, shared_ptr<Holder>(holder), graph);
+	    boost::add_edge(source_vertex, target_vertex, to_pooled(unique_ptr<Holder>(holder)), graph);
 
 	// Since parallel edges are allowed tmp.second must always be true.
 
 	if (!tmp.second)
 	    ST_THROW(LogicException("boost::add_edge behaved unexpectedly"));
 
+	index_edge(tmp.first);
+
+	content_changed();
+	structure_changed();
+
+	mark_unchecked(source_sid);
+	mark_unchecked(target_sid);
+
+	if (check_valid)
+	    unchecked_sid_pairs.emplace_back(source_sid, target_sid);
+
 	// TODO should also set devicegraph and edge in holder but the
 	// devicegraph is not available here
 
@@ -444,6 +865,17 @@ namespace storage
 	if (!tmp.second)
 	    ST_THROW(LogicException("boost::add_edge behaved unexpectedly"));
 
+	index_edge(tmp.first);
+
+	content_changed();
+	structure_changed();
+
+	mark_unchecked(source_sid);
+	mark_unchecked(target_sid);
+
+	if (check_valid)
+	    unchecked_sid_pairs.emplace_back(source_sid, target_sid);
+
 	// TODO should also set devicegraph and edge in holder but the
 	// devicegraph is not available here
 
@@ -478,40 +910,63 @@ namespace storage
     bool
     Devicegraph::Impl::device_exists(sid_t sid) const
     {
-	for (vertex_descriptor vertex : vertices())
-	{
-	    if (graph[vertex]->get_sid() == sid)
-		return true;
-	}
+	materialize(sid);
 
-	return false;
+	return sid_index.find(sid) != sid_index.end();
     }
 
 
     bool
     Devicegraph::Impl::holder_exists(sid_t source_sid, sid_t target_sid) const
     {
-	for (edge_descriptor edge : edges())
-	{
-	    if (graph[source(edge)]->get_sid() == source_sid &&
-		graph[target(edge)]->get_sid() == target_sid)
-		return true;
-	}
+	materialize(source_sid);
 
-	return false;
+	return sid_pair_index.find(make_pair(source_sid, target_sid)) != sid_pair_index.end();
     }
 
 
     Devicegraph::Impl::vertex_descriptor
     Devicegraph::Impl::find_vertex(sid_t sid) const
     {
-	for (vertex_descriptor vertex : vertices())
+	Statistics::count(Statistics::Counter::FIND_VERTEX);
+
+	materialize(sid);
+
+	sid_index_t::const_iterator it = sid_index.find(sid);
+	if (it == sid_index.end())
+	    ST_THROW(DeviceNotFoundBySid(sid));
+
+	return it->second;
+    }
+
+
+    void
+    Devicegraph::Impl::sid_changed(vertex_descriptor vertex, sid_t old_sid)
+    {
+	sid_index_t::const_iterator it = sid_index.find(old_sid);
+	if (it != sid_index.end() && it->second == vertex)
+	    sid_index.erase(it);
+
+	sid_t new_sid = graph[vertex]->get_sid();
+
+	sid_index.emplace(new_sid, vertex);
+
+	content_changed();
+	invalidate_check();
+
+	for (edge_descriptor edge : boost::make_iterator_range(boost::out_edges(vertex, graph)))
 	{
-	    if (graph[vertex]->get_sid() == sid)
-		return vertex;
+	    sid_t target_sid = graph[target(edge)]->get_sid();
+	    unindex_edge(make_pair(old_sid, target_sid), edge);
+	    sid_pair_index.emplace(make_pair(new_sid, target_sid), edge);
 	}
 
-	ST_THROW(DeviceNotFoundBySid(sid));
+	for (edge_descriptor edge : boost::make_iterator_range(boost::in_edges(vertex, graph)))
+	{
+	    sid_t source_sid = graph[source(edge)]->get_sid();
+	    unindex_edge(make_pair(source_sid, old_sid), edge);
+	    sid_pair_index.emplace(make_pair(source_sid, new_sid), edge);
+	}
     }
 
 
@@ -533,14 +988,17 @@ namespace storage
     vector<Devicegraph::Impl::edge_descriptor>
     Devicegraph::Impl::find_edges(sid_t source_sid, sid_t target_sid) const
     {
+	Statistics::count(Statistics::Counter::FIND_EDGES);
+
+	materialize(source_sid);
+
 	vector<Devicegraph::Impl::edge_descriptor> ret;
 
-	for (edge_descriptor edge : edges())
-	{
-	    if (graph[source(edge)]->get_sid() == source_sid &&
-		graph[target(edge)]->get_sid() == target_sid)
-		ret.push_back(edge);
-	}
+	pair<sid_pair_index_t::const_iterator, sid_pair_index_t::const_iterator> range =
+	    sid_pair_index.equal_range(make_pair(source_sid, target_sid));
+
+	for (sid_pair_index_t::const_iterator it = range.first; it != range.second; ++it)
+	    ret.push_back(it->second);
 
 	return ret;
     }
@@ -558,7 +1016,7 @@ namespace storage
     {
 	vertex_descriptor target_vertex = boost::target(old_edge, graph);
 
-	shared_ptr<Holder> new_holder = graph[old_edge].get()->clone_v2();
+	shared_ptr<Holder> new_holder = to_pooled(graph[old_edge].get()->clone_v2());
 
 	Devicegraph::Impl::edge_descriptor new_edge = add_edge_v2(source_vertex, target_vertex,
 								  new_holder);
@@ -580,7 +1038,7 @@ namespace storage
     {
 	vertex_descriptor source_vertex = boost::source(old_edge, graph);
 
-	shared_ptr<Holder> new_holder = graph[old_edge].get()->clone_v2();
+	shared_ptr<Holder> new_holder = to_pooled(graph[old_edge].get()->clone_v2());
 
 	Devicegraph::Impl::edge_descriptor new_edge = add_edge_v2(source_vertex, target_vertex,
 								  new_holder);
@@ -601,39 +1059,252 @@ namespace storage
     Devicegraph::Impl::clear()
     {
 	graph.clear();
+
+	lazy_state.reset();
+
+	sid_index.clear();
+	sid_pair_index.clear();
+	lookup_indexes.clear();
+	type_buckets.clear();
+	type_buckets_valid = true;
+	vertices_by_index.clear();
+
+	content_changed();
+	structure_changed();
+	invalidate_check();
     }
 
 
     void
     Devicegraph::Impl::remove_vertex(vertex_descriptor vertex)
     {
+	sid_index_t::const_iterator it = sid_index.find(graph[vertex]->get_sid());
+	if (it != sid_index.end() && it->second == vertex)
+	    sid_index.erase(it);
+
+	unindex_vertex_for_lookup(vertex);
+	unindex_vertex_by_type(vertex);
+
+	for (edge_descriptor edge : boost::make_iterator_range(boost::out_edges(vertex, graph)))
+	    unindex_edge(make_pair(graph[source(edge)]->get_sid(), graph[target(edge)]->get_sid()), edge);
+
+	for (edge_descriptor edge : boost::make_iterator_range(boost::in_edges(vertex, graph)))
+	    unindex_edge(make_pair(graph[source(edge)]->get_sid(), graph[target(edge)]->get_sid()), edge);
+
+	// The checks of the neighbours may depend on the removed device.
+
+	for (vertex_descriptor tmp : boost::make_iterator_range(boost::adjacent_vertices(vertex, graph)))
+	    mark_unchecked(graph[tmp]->get_sid());
+
+	for (vertex_descriptor tmp : boost::make_iterator_range(boost::inv_adjacent_vertices(vertex, graph)))
+	    mark_unchecked(graph[tmp]->get_sid());
+
+	// Let the last vertex take over the index of the removed vertex to keep
+	// the indexes dense.
+
+	size_t index = boost::get(boost::vertex_index, graph, vertex);
+	vertex_descriptor last_vertex = vertices_by_index.back();
+	boost::put(boost::vertex_index, graph, last_vertex, index);
+	vertices_by_index[index] = last_vertex;
+	vertices_by_index.pop_back();
+
 	boost::clear_vertex(vertex, graph);
 	boost::remove_vertex(vertex, graph);
+
+	content_changed();
+	structure_changed();
     }
 
 
     void
     Devicegraph::Impl::remove_edge(edge_descriptor edge)
     {
-	boost::remove_edge(edge, graph);
-    }
+	unindex_edge(make_pair(graph[source(edge)]->get_sid(), graph[target(edge)]->get_sid()), edge);
 
+	mark_unchecked(graph[source(edge)]->get_sid());
+	mark_unchecked(graph[target(edge)]->get_sid());
 
-    size_t
-    Devicegraph::Impl::num_children(vertex_descriptor vertex, View view) const
-    {
-	filtered_graph_t filtered_graph(graph, make_edge_filter(view), make_vertex_filter(view));
+	boost::remove_edge(edge, graph);
 
-	return boost::out_degree(vertex, filtered_graph);
+	content_changed();
+	structure_changed();
     }
 
 
-    size_t
-    Devicegraph::Impl::num_parents(vertex_descriptor vertex, View view) const
+    void
+    Devicegraph::Impl::remove_vertices(const vector<vertex_descriptor>& vertices)
     {
-	filtered_graph_t filtered_graph(graph, make_edge_filter(view), make_vertex_filter(view));
+	const std::unordered_set<vertex_descriptor> doomed(vertices.begin(), vertices.end());
+
+	for (vertex_descriptor vertex : doomed)
+	{
+	    sid_index_t::const_iterator it = sid_index.find(graph[vertex]->get_sid());
+	    if (it != sid_index.end() && it->second == vertex)
+		sid_index.erase(it);
+
+	    unindex_vertex_for_lookup(vertex);
+
+	    // Edges between two removed vertices are visited twice but
+	    // unindex_edge() ignores edges no longer in the index.
+
+	    for (edge_descriptor edge : boost::make_iterator_range(boost::out_edges(vertex, graph)))
+	    {
+		unindex_edge(make_pair(graph[source(edge)]->get_sid(), graph[target(edge)]->get_sid()), edge);
+		mark_unchecked(graph[target(edge)]->get_sid());
+	    }
+
+	    for (edge_descriptor edge : boost::make_iterator_range(boost::in_edges(vertex, graph)))
+	    {
+		unindex_edge(make_pair(graph[source(edge)]->get_sid(), graph[target(edge)]->get_sid()), edge);
+		mark_unchecked(graph[source(edge)]->get_sid());
+	    }
+
+	    size_t index = boost::get(boost::vertex_index, graph, vertex);
+	    vertex_descriptor last_vertex = vertices_by_index.back();
+	    boost::put(boost::vertex_index, graph, last_vertex, index);
+	    vertices_by_index[index] = last_vertex;
+	    vertices_by_index.pop_back();
+	}
+
+	if (in_batch())
+	{
+	    type_buckets_valid = false;
+	}
+	else if (type_buckets_valid)
+	{
+	    for (std::unordered_map<string, vector<vertex_descriptor>>::value_type& value : type_buckets)
+	    {
+		vector<vertex_descriptor>& bucket = value.second;
+		bucket.erase(remove_if(bucket.begin(), bucket.end(), [&doomed](vertex_descriptor vertex) {
+		    return doomed.count(vertex) != 0;
+		}), bucket.end());
+	    }
+	}
+
+	boost::remove_edge_if([this, &doomed](edge_descriptor edge) {
+	    return doomed.count(source(edge)) != 0 || doomed.count(target(edge)) != 0;
+	}, graph);
+
+	// Now the vertices have no edges left and removing them is cheap.
+
+	for (vertex_descriptor vertex : doomed)
+	    boost::remove_vertex(vertex, graph);
+
+	content_changed();
+	structure_changed();
+    }
+
+
+    void
+    Devicegraph::Impl::begin_batch()
+    {
+	// The lookup indexes are built on demand so dropping them is cheaper
+	// than updating them for every added or removed device.
+
+	if (batch_depth++ == 0)
+	    lookup_indexes.clear();
+    }
+
+
+    bool
+    Devicegraph::Impl::end_batch(bool apply)
+    {
+	if (batch_depth == 0)
+	    ST_THROW(LogicException("no batch to end"));
+
+	if (--batch_depth > 0)
+	    return false;
+
+	if (apply)
+	    update_type_buckets();
+
+	return true;
+    }
+
+
+    bool
+    Devicegraph::Impl::out_edge_in_view_t::operator()(edge_descriptor edge) const
+    {
+	// same as the edge and vertex filters of filtered_graph_t applied to out-edges
+
+	const Holder* holder = (*graph)[edge].get();
+	const Device* target = (*graph)[boost::target(edge, *graph)].get();
+
+	return holder->get_impl().is_in_view(view) && target->get_impl().is_in_view(view);
+    }
+
+
+    bool
+    Devicegraph::Impl::in_edge_in_view_t::operator()(edge_descriptor edge) const
+    {
+	// same as the edge and vertex filters of filtered_graph_t applied to in-edges
+
+	const Holder* holder = (*graph)[edge].get();
+	const Device* source = (*graph)[boost::source(edge, *graph)].get();
+
+	return holder->get_impl().is_in_view(view) && source->get_impl().is_in_view(view);
+    }
+
+
+    boost::iterator_range<Devicegraph::Impl::view_out_edge_iterator>
+    Devicegraph::Impl::out_edges_range(vertex_descriptor vertex, View view) const
+    {
+	const out_edge_in_view_t out_edge_in_view { &graph, view };
+
+	pair<out_edge_iterator, out_edge_iterator> range = boost::out_edges(vertex, graph);
+
+	return boost::make_iterator_range(view_out_edge_iterator(out_edge_in_view, range.first, range.second),
+					  view_out_edge_iterator(out_edge_in_view, range.second, range.second));
+    }
+
+
+    boost::iterator_range<Devicegraph::Impl::view_in_edge_iterator>
+    Devicegraph::Impl::in_edges_range(vertex_descriptor vertex, View view) const
+    {
+	const in_edge_in_view_t in_edge_in_view { &graph, view };
+
+	pair<in_edge_iterator, in_edge_iterator> range = boost::in_edges(vertex, graph);
+
+	return boost::make_iterator_range(view_in_edge_iterator(in_edge_in_view, range.first, range.second),
+					  view_in_edge_iterator(in_edge_in_view, range.second, range.second));
+    }
+
+
+    boost::iterator_range<Devicegraph::Impl::view_child_iterator>
+    Devicegraph::Impl::children_range(vertex_descriptor vertex, View view) const
+    {
+	const edge_target_t edge_target { &graph };
+
+	boost::iterator_range<view_out_edge_iterator> range = out_edges_range(vertex, view);
+
+	return boost::make_iterator_range(view_child_iterator(range.begin(), edge_target),
+					  view_child_iterator(range.end(), edge_target));
+    }
+
+
+    boost::iterator_range<Devicegraph::Impl::view_parent_iterator>
+    Devicegraph::Impl::parents_range(vertex_descriptor vertex, View view) const
+    {
+	const edge_source_t edge_source { &graph };
+
+	boost::iterator_range<view_in_edge_iterator> range = in_edges_range(vertex, view);
+
+	return boost::make_iterator_range(view_parent_iterator(range.begin(), edge_source),
+					  view_parent_iterator(range.end(), edge_source));
+    }
+
+
+    size_t
+    Devicegraph::Impl::num_children(vertex_descriptor vertex, View view) const
+    {
+	return boost::distance(out_edges_range(vertex, view));
+    }
+
 
-	return boost::in_degree(vertex, filtered_graph);
+    size_t
+    Devicegraph::Impl::num_parents(vertex_descriptor vertex, View view) const
+    {
+	return boost::distance(in_edges_range(vertex, view));
     }
 
 
@@ -654,24 +1325,18 @@ namespace storage
     vector<Devicegraph::Impl::vertex_descriptor>
     Devicegraph::Impl::children(vertex_descriptor vertex, View view) const
     {
-	vector<vertex_descriptor> ret;
-
-	for (edge_descriptor edge : out_edges(vertex, view))
-	    ret.push_back(target(edge));
+	boost::iterator_range<view_child_iterator> range = children_range(vertex, view);
 
-	return ret;
+	return vector<vertex_descriptor>(range.begin(), range.end());
     }
 
 
     vector<Devicegraph::Impl::vertex_descriptor>
     Devicegraph::Impl::parents(vertex_descriptor vertex, View view) const
     {
-	vector<vertex_descriptor> ret;
+	boost::iterator_range<view_parent_iterator> range = parents_range(vertex, view);
 
-	for (edge_descriptor edge : in_edges(vertex, view))
-	    ret.push_back(source(edge));
-
-	return ret;
+	return vector<vertex_descriptor>(range.begin(), range.end());
     }
 
 
@@ -680,9 +1345,9 @@ namespace storage
     {
 	vector<vertex_descriptor> ret;
 
-	for (vertex_descriptor parent : parents(vertex, view))
+	for (vertex_descriptor parent : parents_range(vertex, view))
 	{
-	    for (vertex_descriptor child : children(parent, view))
+	    for (vertex_descriptor child : children_range(parent, view))
 	    {
 		if (itself || vertex != child)
 		    ret.push_back(child);
@@ -696,101 +1361,146 @@ namespace storage
     }
 
 
+    template <typename Fnc>
     vector<Devicegraph::Impl::vertex_descriptor>
-    Devicegraph::Impl::descendants(vertex_descriptor vertex, bool itself, View view) const
+    Devicegraph::Impl::memoized_relatives(Relatives relatives, vertex_descriptor vertex, bool itself,
+					  View view, Fnc fnc) const
     {
-	filtered_graph_t filtered_graph(graph, make_edge_filter(view), make_vertex_filter(view));
+	// The View::REMOVE filter depends on the content of devices and holders,
+	// e.g. the type of logical volumes, so only the purely structural views
+	// are memoized.
 
-	VertexIndexMapGenerator<filtered_graph_t> vertex_index_map_generator(filtered_graph);
+	if (view == View::REMOVE)
+	    return fnc();
 
-	vector<vertex_descriptor> ret;
-	VertexRecorder<vertex_descriptor> vertex_recorder(false, ret);
+	const relatives_memo_key_t key(relatives, vertex, itself, view);
+
+	{
+	    std::shared_lock<std::shared_mutex> lock(cache_mutex);
+
+	    if (relatives_memo_generation == structure_generation)
+	    {
+		map<relatives_memo_key_t, vector<vertex_descriptor>>::const_iterator it = relatives_memo.find(key);
+		if (it != relatives_memo.end())
+		    return it->second;
+	    }
+	}
+
+	// Calculate without holding the lock so that concurrent readers are
+	// not blocked.
 
-	boost::breadth_first_search(filtered_graph, vertex, visitor(vertex_recorder).
-				    vertex_index_map(vertex_index_map_generator.get()));
+	vector<vertex_descriptor> ret = fnc();
 
-	if (!itself)
-	    ret.erase(remove(ret.begin(), ret.end(), vertex), ret.end());
+	std::unique_lock<std::shared_mutex> lock(cache_mutex);
+
+	if (relatives_memo_generation != structure_generation)
+	{
+	    relatives_memo.clear();
+	    relatives_memo_generation = structure_generation;
+	}
+
+	relatives_memo.emplace(key, ret);
 
 	return ret;
     }
 
 
+    vector<Devicegraph::Impl::vertex_descriptor>
+    Devicegraph::Impl::descendants(vertex_descriptor vertex, bool itself, View view) const
+    {
+	return memoized_relatives(Relatives::DESCENDANTS, vertex, itself, view, [&]() {
+		StatisticsStopwatch stopwatch(Statistics::Counter::TRAVERSAL);
+
+		filtered_graph_t filtered_graph(graph, make_edge_filter(view), make_vertex_filter(view));
+
+		vector<vertex_descriptor> ret;
+		VertexRecorder<vertex_descriptor> vertex_recorder(false, ret);
+
+		boost::breadth_first_search(filtered_graph, vertex, visitor(vertex_recorder));
+
+		if (!itself)
+		    ret.erase(remove(ret.begin(), ret.end(), vertex), ret.end());
+
+		return ret;
+	});
+    }
+
+
     vector<Devicegraph::Impl::vertex_descriptor>
     Devicegraph::Impl::ancestors(vertex_descriptor vertex, bool itself, View view) const
     {
-	typedef boost::reverse_graph<filtered_graph_t> reverse_graph_t;
+	return memoized_relatives(Relatives::ANCESTORS, vertex, itself, view, [&]() {
+		StatisticsStopwatch stopwatch(Statistics::Counter::TRAVERSAL);
 
-	filtered_graph_t filtered_graph(graph, make_edge_filter(view), make_vertex_filter(view));
-	reverse_graph_t reverse_graph(filtered_graph);
+		typedef boost::reverse_graph<filtered_graph_t> reverse_graph_t;
 
-	VertexIndexMapGenerator<reverse_graph_t> vertex_index_map_generator(reverse_graph);
+		filtered_graph_t filtered_graph(graph, make_edge_filter(view), make_vertex_filter(view));
+		reverse_graph_t reverse_graph(filtered_graph);
 
-	vector<vertex_descriptor> ret;
-	VertexRecorder<vertex_descriptor> vertex_recorder(false, ret);
+		vector<vertex_descriptor> ret;
+		VertexRecorder<vertex_descriptor> vertex_recorder(false, ret);
 
-	boost::breadth_first_search(reverse_graph, vertex, visitor(vertex_recorder).
-				    vertex_index_map(vertex_index_map_generator.get()));
+		boost::breadth_first_search(reverse_graph, vertex, visitor(vertex_recorder));
 
-	if (!itself)
-	    ret.erase(remove(ret.begin(), ret.end(), vertex), ret.end());
+		if (!itself)
+		    ret.erase(remove(ret.begin(), ret.end(), vertex), ret.end());
 
-	return ret;
+		return ret;
+	});
     }
 
 
     vector<Devicegraph::Impl::vertex_descriptor>
     Devicegraph::Impl::leaves(vertex_descriptor vertex, bool itself, View view) const
     {
-	filtered_graph_t filtered_graph(graph, make_edge_filter(view), make_vertex_filter(view));
+	return memoized_relatives(Relatives::LEAVES, vertex, itself, view, [&]() {
+		StatisticsStopwatch stopwatch(Statistics::Counter::TRAVERSAL);
 
-	VertexIndexMapGenerator<filtered_graph_t> vertex_index_map_generator(filtered_graph);
+		filtered_graph_t filtered_graph(graph, make_edge_filter(view), make_vertex_filter(view));
 
-	vector<vertex_descriptor> ret;
-	VertexRecorder<vertex_descriptor> vertex_recorder(true, ret);
+		vector<vertex_descriptor> ret;
+		VertexRecorder<vertex_descriptor> vertex_recorder(true, ret);
 
-	boost::breadth_first_search(filtered_graph, vertex, visitor(vertex_recorder).
-				    vertex_index_map(vertex_index_map_generator.get()));
+		boost::breadth_first_search(filtered_graph, vertex, visitor(vertex_recorder));
 
-	if (!itself)
-	    ret.erase(remove(ret.begin(), ret.end(), vertex), ret.end());
+		if (!itself)
+		    ret.erase(remove(ret.begin(), ret.end(), vertex), ret.end());
 
-	return ret;
+		return ret;
+	});
     }
 
 
     vector<Devicegraph::Impl::vertex_descriptor>
     Devicegraph::Impl::roots(vertex_descriptor vertex, bool itself, View view) const
     {
-	typedef boost::reverse_graph<filtered_graph_t> reverse_graph_t;
+	return memoized_relatives(Relatives::ROOTS, vertex, itself, view, [&]() {
+		StatisticsStopwatch stopwatch(Statistics::Counter::TRAVERSAL);
 
-	filtered_graph_t filtered_graph(graph, make_edge_filter(view), make_vertex_filter(view));
-	reverse_graph_t reverse_graph(filtered_graph);
+		typedef boost::reverse_graph<filtered_graph_t> reverse_graph_t;
 
-	VertexIndexMapGenerator<reverse_graph_t> vertex_index_map_generator(filtered_graph);
+		filtered_graph_t filtered_graph(graph, make_edge_filter(view), make_vertex_filter(view));
+		reverse_graph_t reverse_graph(filtered_graph);
 
-	vector<vertex_descriptor> ret;
-	VertexRecorder<vertex_descriptor> vertex_recorder(true, ret);
+		vector<vertex_descriptor> ret;
+		VertexRecorder<vertex_descriptor> vertex_recorder(true, ret);
 
-	boost::breadth_first_search(reverse_graph, vertex, visitor(vertex_recorder).
-				    vertex_index_map(vertex_index_map_generator.get()));
+		boost::breadth_first_search(reverse_graph, vertex, visitor(vertex_recorder));
 
-	if (!itself)
-	    ret.erase(remove(ret.begin(), ret.end(), vertex), ret.end());
+		if (!itself)
+		    ret.erase(remove(ret.begin(), ret.end(), vertex), ret.end());
 
-	return ret;
+		return ret;
+	});
     }
 
 
     Devicegraph::Impl::edge_descriptor
     Devicegraph::Impl::in_edge(vertex_descriptor vertex, View view) const
     {
-	filtered_graph_t filtered_graph(graph, make_edge_filter(view), make_vertex_filter(view));
-
-	boost::iterator_range<filtered_graph_t::in_edge_iterator> range =
-	    boost::make_iterator_range(boost::in_edges(vertex, filtered_graph));
+	boost::iterator_range<view_in_edge_iterator> range = in_edges_range(vertex, view);
 
-	size_t size = distance(range.begin(), range.end());
+	size_t size = boost::distance(range);
 	if (size != 1)
 	    ST_THROW(WrongNumberOfParents(size, 1));
 
@@ -801,12 +1511,9 @@ namespace storage
     Devicegraph::Impl::edge_descriptor
     Devicegraph::Impl::out_edge(vertex_descriptor vertex, View view) const
     {
-	filtered_graph_t filtered_graph(graph, make_edge_filter(view), make_vertex_filter(view));
-
-	boost::iterator_range<filtered_graph_t::out_edge_iterator> range =
-	    boost::make_iterator_range(boost::out_edges(vertex, filtered_graph));
+	boost::iterator_range<view_out_edge_iterator> range = out_edges_range(vertex, view);
 
-	size_t size = distance(range.begin(), range.end());
+	size_t size = boost::distance(range);
 	if (size != 1)
 	    ST_THROW(WrongNumberOfChildren(size, 1));
 
@@ -817,10 +1524,7 @@ namespace storage
     vector<Devicegraph::Impl::edge_descriptor>
     Devicegraph::Impl::in_edges(vertex_descriptor vertex, View view) const
     {
-	filtered_graph_t filtered_graph(graph, make_edge_filter(view), make_vertex_filter(view));
-
-	boost::iterator_range<filtered_graph_t::in_edge_iterator> range =
-	    boost::make_iterator_range(boost::in_edges(vertex, filtered_graph));
+	boost::iterator_range<view_in_edge_iterator> range = in_edges_range(vertex, view);
 
 	return vector<edge_descriptor>(range.begin(), range.end());
     }
@@ -829,105 +1533,376 @@ namespace storage
     vector<Devicegraph::Impl::edge_descriptor>
     Devicegraph::Impl::out_edges(vertex_descriptor vertex, View view) const
     {
-	filtered_graph_t filtered_graph(graph, make_edge_filter(view), make_vertex_filter(view));
-
-	boost::iterator_range<filtered_graph_t::out_edge_iterator> range =
-	    boost::make_iterator_range(boost::out_edges(vertex, filtered_graph));
+	boost::iterator_range<view_out_edge_iterator> range = out_edges_range(vertex, view);
 
 	return vector<edge_descriptor>(range.begin(), range.end());
     }
 
 
     void
-    Devicegraph::Impl::load(Devicegraph* devicegraph, const string& filename, bool keep_sids)
+    Devicegraph::Impl::load_device(Devicegraph* devicegraph, const string& classname, const xmlNode* node)
+    {
+	map<string, device_load_fnc>::const_iterator it = device_load_registry.find(classname);
+	if (it == device_load_registry.end())
+	    ST_THROW(Exception(sformat("unknown device class name %s", classname)));
+
+	const Device* device = it->second(devicegraph, node);
+	Storage::Impl::raise_global_sid(device->get_sid());
+    }
+
+
+    void
+    Devicegraph::Impl::load_holder(Devicegraph* devicegraph, const string& classname, const xmlNode* node)
+    {
+	map<string, holder_load_fnc>::const_iterator it = holder_load_registry.find(classname);
+	if (it == holder_load_registry.end())
+	    ST_THROW(Exception(sformat("unknown holder class name %s", classname)));
+
+	it->second(devicegraph, node);
+    }
+
+
+    void
+    Devicegraph::Impl::load(Devicegraph* devicegraph, const string& filename, bool keep_sids, bool lazy)
     {
 	if (&devicegraph->get_impl() != this)
 	    ST_THROW(LogicException("wrong impl-ptr"));
 
 	clear();
 
-	XmlFile xml(filename);
+	// Changing the sids needs all devices so in that case lazy loading is
+	// pointless.
+
+	if (lazy && keep_sids)
+	    load_lazy(devicegraph, filename);
+	else
+	    load_xml(devicegraph, filename);
+
+	if (!keep_sids)
+	{
+	    for (vertex_descriptor vertex : vertices())
+	    {
+		Device* device = graph[vertex].get();
+		device->get_impl().set_sid(Storage::Impl::get_next_sid());
+	    }
+
+	    rebuild_indexes();
+	}
+    }
+
+
+    void
+    Devicegraph::Impl::read_xml(const string& filename, const std::function<void(bool device, const xmlNode* node)>& fnc)
+    {
+	// The file is read element by element. Only the subtree of a single
+	// device or holder is expanded at any time so memory usage does not
+	// depend on the size of the devicegraph.
+
+	XmlFileReader reader(filename);
 
-	const xmlNode* root_node = xml.getRootElement();
-	if (!root_node)
+	bool ok = reader.read();
+	while (ok && !reader.is_element())
+	    ok = reader.read();
+
+	if (!ok)
 	    ST_THROW(Exception("root node not found"));
 
-	const xmlNode* devicegraph_node = getChildNode(root_node, "Devicegraph");
-	if (!devicegraph_node)
+	if (strcmp(reader.get_name(), "Devicegraph") != 0)
 	    ST_THROW(Exception("Devicegraph node not found"));
 
-	const xmlNode* devices_node = getChildNode(devicegraph_node, "Devices");
-	if (devices_node)
+	string section;
+
+	ok = reader.read();
+	while (ok)
 	{
-	    for (const xmlNode* device_node : getChildNodes(devices_node))
+	    if (!reader.is_element())
 	    {
-		const string& classname = (const char*) device_node->parent->name;
+		ok = reader.read();
+		continue;
+	    }
 
-		map<string, device_load_fnc>::const_iterator it = device_load_registry.find(classname);
-		if (it == device_load_registry.end())
-		    ST_THROW(Exception(sformat("unknown device class name %s", classname)));
+	    if (reader.get_depth() == 1)
+	    {
+		section = reader.get_name();
+		ok = reader.read();
+		continue;
+	    }
 
-		const Device* device = it->second(devicegraph, device_node);
-		Storage::Impl::raise_global_sid(device->get_sid());
+	    if (reader.get_depth() != 2 || (section != "Devices" && section != "Holders"))
+	    {
+		ok = reader.next();
+		continue;
 	    }
+
+	    fnc(section == "Devices", reader.expand());
+
+	    ok = reader.next();
 	}
+    }
 
-	const xmlNode* holders_node = getChildNode(devicegraph_node, "Holders");
-	if (holders_node)
-	{
-	    for (const xmlNode* holder_node : getChildNodes(holders_node))
+
+    void
+    Devicegraph::Impl::load_xml(Devicegraph* devicegraph, const string& filename)
+    {
+	read_xml(filename, [this, devicegraph](bool device, const xmlNode* node) {
+	    if (device)
+		load_device(devicegraph, (const char*) node->name, node->children);
+	    else
+		load_holder(devicegraph, (const char*) node->name, node->children);
+	});
+    }
+
+
+    void
+    Devicegraph::Impl::load_lazy(Devicegraph* devicegraph, const string& filename)
+    {
+	lazy_state = make_unique<LazyState>(devicegraph);
+
+	LazyState& state = *lazy_state;
+
+	// Only the sids are read from the nodes. Creating the devices and
+	// holders is deferred.
+
+	vector<sid_t> device_sids;
+	vector<pair<sid_t, sid_t>> holder_sids;
+
+	read_xml(filename, [&state, &device_sids, &holder_sids](bool device, const xmlNode* node) {
+
+	    if (device)
+	    {
+		sid_t sid = 0;
+		if (!getChildValue(node->children, "sid", sid))
+		    ST_THROW(Exception("no sid"));
+
+		device_sids.push_back(sid);
+		state.device_nodes.push_back(xmlCopyNode(const_cast<xmlNode*>(node), 1));
+	    }
+	    else
 	    {
-		const string& classname = (const char*) holder_node->parent->name;
+		sid_t source_sid = 0;
+		if (!getChildValue(node->children, "source-sid", source_sid))
+		    ST_THROW(Exception("no source-sid"));
 
-		map<string, holder_load_fnc>::const_iterator it = holder_load_registry.find(classname);
-		if (it == holder_load_registry.end())
-		    ST_THROW(Exception(sformat("unknown holder class name %s", classname)));
+		sid_t target_sid = 0;
+		if (!getChildValue(node->children, "target-sid", target_sid))
+		    ST_THROW(Exception("no target-sid"));
 
-		it->second(devicegraph, holder_node);
+		holder_sids.emplace_back(source_sid, target_sid);
+		state.holder_nodes.push_back(xmlCopyNode(const_cast<xmlNode*>(node), 1));
 	    }
+	});
+
+	// Find the connected components using union-find on the devices.
+
+	std::unordered_map<sid_t, uint32_t> records_by_sid;
+
+	vector<uint32_t> roots(device_sids.size());
+
+	for (uint32_t i = 0; i < device_sids.size(); ++i)
+	{
+	    sid_t sid = device_sids[i];
+
+	    records_by_sid[sid] = i;
+	    roots[i] = i;
+
+	    Storage::Impl::raise_global_sid(sid);
 	}
 
-	if (!keep_sids)
+	auto find_root = [&roots](uint32_t i) {
+	    while (roots[i] != i)
+		i = roots[i] = roots[roots[i]];
+	    return i;
+	};
+
+	auto find_record = [&records_by_sid](sid_t sid) {
+	    std::unordered_map<sid_t, uint32_t>::const_iterator it = records_by_sid.find(sid);
+	    if (it == records_by_sid.end())
+		ST_THROW(DeviceNotFoundBySid(sid));
+	    return it->second;
+	};
+
+	for (const pair<sid_t, sid_t>& sids : holder_sids)
 	{
-	    for (vertex_descriptor vertex : vertices())
+	    uint32_t source_root = find_root(find_record(sids.first));
+	    uint32_t target_root = find_root(find_record(sids.second));
+
+	    roots[max(source_root, target_root)] = min(source_root, target_root);
+	}
+
+	// Components are numbered in the order of their first device so that
+	// materialize_all() keeps the order of the file.
+
+	std::unordered_map<uint32_t, size_t> components_by_root;
+
+	for (uint32_t i = 0; i < device_sids.size(); ++i)
+	{
+	    uint32_t root = find_root(i);
+
+	    std::unordered_map<uint32_t, size_t>::const_iterator it =
+		components_by_root.emplace(root, components_by_root.size()).first;
+
+	    if (it->second == state.device_records.size())
 	    {
-		Device* device = graph[vertex].get();
-		device->get_impl().set_sid(Storage::Impl::get_next_sid());
+		state.device_records.emplace_back();
+		state.holder_records.emplace_back();
 	    }
+
+	    state.device_records[it->second].push_back(i);
+	    state.components_by_sid[device_sids[i]] = it->second;
 	}
+
+	for (uint32_t i = 0; i < holder_sids.size(); ++i)
+	{
+	    size_t component = state.components_by_sid[holder_sids[i].first];
+	    state.holder_records[component].push_back(i);
+	}
+
+	state.materialized.assign(state.device_records.size(), false);
+	state.num_unmaterialized_devices = device_sids.size();
+	state.num_unmaterialized_holders = holder_sids.size();
+
+	y2mil("lazy load of " << device_sids.size() << " devices in " << state.device_records.size() <<
+	      " components");
+
+	if (state.device_records.empty())
+	    lazy_state.reset();
     }
 
 
     void
-    Devicegraph::Impl::save(const string& filename) const
+    Devicegraph::Impl::materialize_component_of(sid_t sid) const
     {
-	XmlFile xml;
+	if (lazy_state->materializing)
+	    return;
 
-	xmlNode* devicegraph_node = xmlNewNode("Devicegraph");
-	xml.setRootElement(devicegraph_node);
+	std::unordered_map<sid_t, size_t>::const_iterator it = lazy_state->components_by_sid.find(sid);
+	if (it == lazy_state->components_by_sid.end())
+	    return;
 
-	xmlNode* comment = xmlNewComment(string(" " + generated_string() + " ").c_str());
-	xmlAddPrevSibling(devicegraph_node, comment);
+	materialize_component(it->second);
 
-	xmlNode* devices_node = xmlNewChild(devicegraph_node, "Devices");
+	if (lazy_state->num_materialized == lazy_state->materialized.size())
+	    lazy_state.reset();
+    }
 
-	for (vertex_descriptor vertex : vertices())
+
+    void
+    Devicegraph::Impl::materialize_all_components() const
+    {
+	if (lazy_state->materializing)
+	    return;
+
+	for (size_t component = 0; component < lazy_state->materialized.size(); ++component)
+	    materialize_component(component);
+
+	lazy_state.reset();
+    }
+
+
+    void
+    Devicegraph::Impl::materialize_component(size_t component) const
+    {
+	LazyState& state = *lazy_state;
+
+	if (state.materialized[component])
+	    return;
+
+	state.materialized[component] = true;
+	++state.num_materialized;
+
+	state.materializing = true;
+
+	try
 	{
-	    const Device* device = graph[vertex].get();
-	    xmlNode* device_node = xmlNewChild(devices_node, device->get_impl().get_classname());
-	    device->get_impl().save(device_node);
+	    Impl& impl = state.devicegraph->get_impl();
+
+	    for (uint32_t i : state.device_records[component])
+	    {
+		xmlNode*& node = state.device_nodes[i];
+
+		impl.load_device(state.devicegraph, (const char*) node->name, node->children);
+		xmlFreeNode(node);
+		node = nullptr;
+
+		--state.num_unmaterialized_devices;
+	    }
+
+	    for (uint32_t i : state.holder_records[component])
+	    {
+		xmlNode*& node = state.holder_nodes[i];
+
+		impl.load_holder(state.devicegraph, (const char*) node->name, node->children);
+		xmlFreeNode(node);
+		node = nullptr;
+
+		--state.num_unmaterialized_holders;
+	    }
+	}
+	catch (...)
+	{
+	    state.materializing = false;
+	    throw;
 	}
 
-	xmlNode* holders_node = xmlNewChild(devicegraph_node, "Holders");
+	state.materializing = false;
+    }
 
-	for (edge_descriptor edge : edges())
+
+    void
+    Devicegraph::Impl::save(const string& filename) const
+    {
+	// Each device and holder is saved to a separate node which is written
+	// and freed immediately so the complete document is never in memory.
+
+	XmlFileWriter writer(filename);
+
+	writer.write("<?xml version=\"1.0\"?>\n");
+	writer.write("<!-- " + generated_string() + " -->\n");
+	writer.write("<Devicegraph>\n");
+
+	if (num_devices() == 0)
 	{
-	    const Holder* holder = graph[edge].get();
-	    xmlNode* holder_node = xmlNewChild(holders_node, holder->get_impl().get_classname());
-	    holder->get_impl().save(holder_node);
+	    writer.write("  <Devices/>\n");
+	}
+	else
+	{
+	    writer.write("  <Devices>\n");
+
+	    for (vertex_descriptor vertex : vertices())
+	    {
+		const Device* device = graph[vertex].get();
+		xmlNode* device_node = xmlNewNode(device->get_impl().get_classname());
+		device->get_impl().save(device_node);
+		writer.write(device_node, 2);
+		xmlFreeNode(device_node);
+	    }
+
+	    writer.write("  </Devices>\n");
+	}
+
+	if (num_holders() == 0)
+	{
+	    writer.write("  <Holders/>\n");
+	}
+	else
+	{
+	    writer.write("  <Holders>\n");
+
+	    for (edge_descriptor edge : edges())
+	    {
+		const Holder* holder = graph[edge].get();
+		xmlNode* holder_node = xmlNewNode(holder->get_impl().get_classname());
+		holder->get_impl().save(holder_node);
+		writer.write(holder_node, 2);
+		xmlFreeNode(holder_node);
+	    }
+
+	    writer.write("  </Holders>\n");
 	}
 
-	if (!xml.save_to_file(filename))
+	writer.write("</Devicegraph>\n");
+
+	if (!writer.close())
 	    ST_THROW(Exception(sformat("failed to write '%s'", filename)));
     }
 
@@ -1017,8 +1992,8 @@ namespace storage
 	fout << "// " << generated_string() << "\n\n";
 
 	// Build up a property map with the sid to be used for the
-	// vertex id. Same as VertexIndexMapGenerator but with the sid
-	// instead of a generated index. Why? For once the sid is
+	// vertex id. Same as the vertex index but with the sid
+	// instead of the dense index. Why? For once the sid is
 	// needed as id for the ranks. Also other programs can query
 	// the id when the user clicks on a node and thus can lookup
 	// the device easily.
@@ -1043,6 +2018,306 @@ namespace storage
     }
 
 
+    void
+    Devicegraph::Impl::rebuild_indexes()
+    {
+	sid_index.clear();
+	sid_index.reserve(num_devices());
+
+	type_buckets.clear();
+	type_buckets_valid = true;
+
+	vertices_by_index.clear();
+	vertices_by_index.reserve(num_devices());
+
+	for (vertex_descriptor vertex : vertices())
+	{
+	    boost::put(boost::vertex_index, graph, vertex, vertices_by_index.size());
+	    vertices_by_index.push_back(vertex);
+
+	    sid_index.emplace(graph[vertex]->get_sid(), vertex);
+	    index_vertex_by_type(vertex);
+	}
+
+	sid_pair_index.clear();
+	sid_pair_index.reserve(num_holders());
+
+	for (edge_descriptor edge : edges())
+	    index_edge(edge);
+
+	lookup_indexes.clear();
+
+	content_changed();
+	structure_changed();
+	invalidate_check();
+    }
+
+
+    void
+    Devicegraph::Impl::copy_indexes(const Impl& source, const vector<vertex_descriptor>& orig_to_copy)
+    {
+	auto translate = [&source, &orig_to_copy](vertex_descriptor vertex) {
+	    return orig_to_copy[boost::get(boost::vertex_index, source.graph, vertex)];
+	};
+
+	// The copies get the same vertex indexes as the originals.
+
+	vertices_by_index = orig_to_copy;
+
+	for (size_t i = 0; i < vertices_by_index.size(); ++i)
+	    boost::put(boost::vertex_index, graph, vertices_by_index[i], i);
+
+	sid_index.reserve(source.sid_index.size());
+
+	for (const sid_index_t::value_type& value : source.sid_index)
+	    sid_index.emplace(value.first, translate(value.second));
+
+	source.update_type_buckets();
+
+	for (const auto& value : source.type_buckets)
+	{
+	    vector<vertex_descriptor>& bucket = type_buckets[value.first];
+
+	    bucket.reserve(value.second.size());
+
+	    for (vertex_descriptor vertex : value.second)
+		bucket.push_back(translate(vertex));
+	}
+
+	for (const auto& value : source.lookup_indexes)
+	{
+	    lookup_index_t& lookup_index = lookup_indexes[value.first];
+
+	    lookup_index.key_of = value.second.key_of;
+
+	    lookup_index.entries.reserve(value.second.entries.size());
+
+	    for (const lookup_index_t::entries_t::value_type& entry : value.second.entries)
+		lookup_index.entries.emplace(entry.first, translate(entry.second));
+	}
+
+	// copy_graph provides no mapping of the edges.
+
+	sid_pair_index.reserve(num_holders());
+
+	for (edge_descriptor edge : edges())
+	    index_edge(edge);
+
+	content_changed();
+	structure_changed();
+	invalidate_check();
+    }
+
+
+    void
+    Devicegraph::Impl::index_edge(edge_descriptor edge)
+    {
+	sid_pair_index.emplace(make_pair(graph[source(edge)]->get_sid(), graph[target(edge)]->get_sid()), edge);
+    }
+
+
+    void
+    Devicegraph::Impl::unindex_edge(sid_pair_t sid_pair, edge_descriptor edge)
+    {
+	pair<sid_pair_index_t::iterator, sid_pair_index_t::iterator> range = sid_pair_index.equal_range(sid_pair);
+
+	for (sid_pair_index_t::iterator it = range.first; it != range.second; ++it)
+	{
+	    if (it->second == edge)
+	    {
+		sid_pair_index.erase(it);
+		return;
+	    }
+	}
+    }
+
+
+    void
+    Devicegraph::Impl::index_vertex_for_lookup(vertex_descriptor vertex)
+    {
+	string key;
+
+	for (map<lookup_index_key_t, lookup_index_t>::value_type& value : lookup_indexes)
+	{
+	    lookup_index_t& lookup_index = value.second;
+
+	    if (lookup_index.key_of(graph[vertex].get(), key))
+		lookup_index.entries.emplace(key, vertex);
+	}
+    }
+
+
+    void
+    Devicegraph::Impl::unindex_vertex_for_lookup(vertex_descriptor vertex)
+    {
+	string key;
+
+	for (map<lookup_index_key_t, lookup_index_t>::value_type& value : lookup_indexes)
+	{
+	    lookup_index_t& lookup_index = value.second;
+
+	    if (!lookup_index.key_of(graph[vertex].get(), key))
+		continue;
+
+	    pair<lookup_index_t::entries_t::iterator, lookup_index_t::entries_t::iterator> range =
+		lookup_index.entries.equal_range(key);
+
+	    for (lookup_index_t::entries_t::iterator it = range.first; it != range.second; ++it)
+	    {
+		if (it->second == vertex)
+		{
+		    lookup_index.entries.erase(it);
+		    break;
+		}
+	    }
+	}
+    }
+
+
+    const vector<Devicegraph::Impl::vertex_descriptor>&
+    Devicegraph::Impl::vertices_of_type(const char* classname) const
+    {
+	materialize_all();
+
+	update_type_buckets();
+
+	std::unordered_map<string, vector<vertex_descriptor>>::const_iterator it = type_buckets.find(classname);
+	if (it != type_buckets.end())
+	    return it->second;
+
+	const static vector<vertex_descriptor> empty;
+	return empty;
+    }
+
+
+    void
+    Devicegraph::Impl::index_vertex_by_type(vertex_descriptor vertex)
+    {
+	if (type_buckets_valid)
+	    add_to_type_buckets(vertex);
+    }
+
+
+    void
+    Devicegraph::Impl::add_to_type_buckets(vertex_descriptor vertex) const
+    {
+	const Device* device = graph[vertex].get();
+
+	string classname = device->get_impl().get_classname();
+
+	while (classname != DeviceTraits<Device>::classname)
+	{
+	    type_buckets[classname].push_back(vertex);
+
+	    map<string, string>::const_iterator it = device_base_registry.find(classname);
+	    if (it == device_base_registry.end())
+		ST_THROW(LogicException(sformat("unknown device class name %s", classname)));
+
+	    classname = it->second;
+	}
+    }
+
+
+    void
+    Devicegraph::Impl::unindex_vertex_by_type(vertex_descriptor vertex)
+    {
+	if (!type_buckets_valid)
+	    return;
+
+	// Erasing from the buckets is linear in the bucket size so within a
+	// batch the buckets are rebuilt once instead.
+
+	if (in_batch())
+	{
+	    type_buckets_valid = false;
+	    return;
+	}
+
+	const Device* device = graph[vertex].get();
+
+	string classname = device->get_impl().get_classname();
+
+	while (classname != DeviceTraits<Device>::classname)
+	{
+	    vector<vertex_descriptor>& bucket = type_buckets[classname];
+	    bucket.erase(remove(bucket.begin(), bucket.end(), vertex), bucket.end());
+
+	    classname = device_base_registry.at(classname);
+	}
+    }
+
+
+    void
+    Devicegraph::Impl::update_type_buckets() const
+    {
+	if (type_buckets_valid)
+	    return;
+
+	std::unique_lock<std::shared_mutex> lock(cache_mutex);
+
+	if (type_buckets_valid)
+	    return;
+
+	type_buckets.clear();
+
+	for (vertex_descriptor vertex : vertices())
+	    add_to_type_buckets(vertex);
+
+	type_buckets_valid = true;
+    }
+
+
+    size_t
+    Devicegraph::Impl::get_content_hash() const
+    {
+	if (content_hash_valid)
+	    return content_hash;
+
+	// The content hashes of the devices and holders are also cached so
+	// calculate under the lock.
+
+	std::unique_lock<std::shared_mutex> lock(cache_mutex);
+
+	if (!content_hash_valid)
+	{
+	    // Sum up the hashes so that the order of the vertices and edges does
+	    // not matter.
+
+	    size_t sum = 0;
+
+	    for (vertex_descriptor vertex : vertices())
+		sum += (*this)[vertex]->get_impl().get_content_hash();
+
+	    for (edge_descriptor edge : edges())
+	    {
+		size_t seed = (*this)[edge]->get_impl().get_content_hash();
+		boost::hash_combine(seed, graph[source(edge)]->get_sid());
+		boost::hash_combine(seed, graph[target(edge)]->get_sid());
+
+		sum += seed;
+	    }
+
+	    content_hash = sum;
+	    content_hash_valid = true;
+	}
+
+	return content_hash;
+    }
+
+
+    void
+    Devicegraph::Impl::set_lookup_key(vertex_descriptor vertex, string& key, const string& value)
+    {
+	std::unique_lock<std::shared_mutex> lock(cache_mutex);
+
+	unindex_vertex_for_lookup(vertex);
+
+	key = value;
+
+	index_vertex_for_lookup(vertex);
+    }
+
+
     Devicegraph::Impl::vertex_filter_t
     Devicegraph::Impl::make_vertex_filter(View view) const
     {
@@ -26,14 +26,27 @@
 
 
 #include <set>
+#include <map>
+#include <tuple>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <typeindex>
+#include <functional>
 #include <boost/noncopyable.hpp>
+#include <boost/functional/hash.hpp>
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/filtered_graph.hpp>
+#include <boost/iterator/filter_iterator.hpp>
+#include <boost/iterator/transform_iterator.hpp>
 
 #include "storage/Devices/Device.h"
 #include "storage/Holders/Holder.h"
 #include "storage/Devicegraph.h"
 #include "storage/View.h"
+#include "storage/Utils/Statistics.h"
 
 
 namespace storage
@@ -42,11 +55,25 @@ namespace storage
     using std::vector;
     using std::set;
     using std::pair;
+    using std::map;
 
 
     using sid_pair_t = pair<sid_t, sid_t>;
 
 
+    template <typename Type> struct DeviceTraits;
+
+
+    /**
+     * Keys for which lookup indexes are available, see
+     * Devicegraph::Impl::lookup_vertices().
+     */
+    enum class LookupKey
+    {
+	NAME, UUID
+    };
+
+
     class Devicegraph::Impl : private boost::noncopyable
     {
 
@@ -62,8 +89,15 @@ namespace storage
 	// properties, see:
 	// http://www.boost.org/doc/libs/1_56_0/libs/graph/doc/bundles.html
 
+	// Additionally every vertex has a dense index in [0, num_devices()) as
+	// internal vertex_index property. Since it is the default vertex index
+	// map of the BGL algorithms no index map must be generated for them.
+	// The index is maintained by add_vertex_v2() and remove_vertex().
+
+	typedef boost::property<boost::vertex_index_t, size_t, std::shared_ptr<Device>> vertex_property_t;
+
 	typedef boost::adjacency_list<boost::listS, boost::listS, boost::bidirectionalS,
-				      std::shared_ptr<Device>, std::shared_ptr<Holder>> graph_t;
+				      vertex_property_t, std::shared_ptr<Holder>> graph_t;
 
 	typedef graph_t::vertex_descriptor vertex_descriptor;
 	typedef graph_t::edge_descriptor edge_descriptor;
@@ -84,12 +118,61 @@ namespace storage
 
 	typedef boost::filtered_graph<graph_t, edge_filter_t, vertex_filter_t> filtered_graph_t;
 
+	// Predicates and functions for the lazy ranges below. Unlike
+	// filtered_graph_t they do not need std::function objects.
 
-	Impl(Storage* storage) : storage(storage) {}
+	struct out_edge_in_view_t
+	{
+	    const graph_t* graph;
+	    View view;
+
+	    bool operator()(edge_descriptor edge) const;
+	};
+
+	struct in_edge_in_view_t
+	{
+	    const graph_t* graph;
+	    View view;
+
+	    bool operator()(edge_descriptor edge) const;
+	};
+
+	struct edge_target_t
+	{
+	    const graph_t* graph;
+
+	    vertex_descriptor operator()(edge_descriptor edge) const { return boost::target(edge, *graph); }
+	};
+
+	struct edge_source_t
+	{
+	    const graph_t* graph;
+
+	    vertex_descriptor operator()(edge_descriptor edge) const { return boost::source(edge, *graph); }
+	};
+
+	typedef boost::filter_iterator<out_edge_in_view_t, out_edge_iterator> view_out_edge_iterator;
+	typedef boost::filter_iterator<in_edge_in_view_t, in_edge_iterator> view_in_edge_iterator;
+
+	typedef boost::transform_iterator<edge_target_t, view_out_edge_iterator> view_child_iterator;
+	typedef boost::transform_iterator<edge_source_t, view_in_edge_iterator> view_parent_iterator;
+
+	typedef std::unordered_map<sid_t, vertex_descriptor> sid_index_t;
+	typedef std::unordered_multimap<sid_pair_t, edge_descriptor, boost::hash<sid_pair_t>> sid_pair_index_t;
+
+
+	Impl(Storage* storage);
+	~Impl();
 
 	bool operator==(const Impl& rhs) const;
 	bool operator!=(const Impl& rhs) const { return !(*this == rhs); }
 
+	/**
+	 * Checks the devicegraph. After a successful check only devices
+	 * changed since then, their ancestors and descendants are checked
+	 * again and only new edges are searched for cycles. Devices that
+	 * reported errors via check_callbacks are always checked again.
+	 */
 	void check(const CheckCallbacks* check_callbacks) const;
 
 	uf_t used_features(UsedFeaturesDependencyType used_features_dependency_type) const;
@@ -133,6 +216,12 @@ namespace storage
 	bool holder_exists(sid_t source_sid, sid_t target_sid) const;
 
 	vertex_descriptor find_vertex(sid_t sid) const;
+
+	/**
+	 * Must be called when the sid of the device of vertex changed, e.g. via
+	 * Device::Impl::set_sid(), to keep the sid indexes up to date.
+	 */
+	void sid_changed(vertex_descriptor vertex, sid_t old_sid);
 	edge_descriptor find_edge(sid_t source_sid, sid_t target_sid) const;
 	vector<edge_descriptor> find_edges(sid_t source_sid, sid_t target_sid) const;
 	vector<edge_descriptor> find_edges(sid_pair_t sid_pair) const;
@@ -154,10 +243,44 @@ namespace storage
 	void remove_vertex(vertex_descriptor vertex);
 	void remove_edge(edge_descriptor edge);
 
+	/**
+	 * Removes the vertices and all their edges. Unlike repeated calls of
+	 * remove_vertex() the edges are removed in one sweep over the edge
+	 * list and the type buckets are filtered once.
+	 */
+	void remove_vertices(const vector<vertex_descriptor>& vertices);
+
+	/**
+	 * See Devicegraph::Batch. Batches can be nested.
+	 */
+	void begin_batch();
+
+	/**
+	 * Ends a batch. Returns true if the outermost batch ended. Only with
+	 * apply the type buckets are updated, otherwise that is done on
+	 * next use.
+	 */
+	bool end_batch(bool apply = true);
+
+	bool in_batch() const { return batch_depth > 0; }
+
+	/**
+	 * Whether the bcache numbers must be reassigned at the end of the
+	 * batch, see Devicegraph::remove_device().
+	 */
+	bool bcache_numbers_outdated = false;
+
 	boost::iterator_range<vertex_iterator> vertices() const;
 	boost::iterator_range<edge_iterator> edges() const;
 
-	void load(Devicegraph* devicegraph, const string& filename, bool keep_sids);
+	/**
+	 * Loads the devicegraph from a file.
+	 *
+	 * With lazy and keep_sids the file is only parsed. The devices and
+	 * holders are created when they are accessed, see materialize().
+	 */
+	void load(Devicegraph* devicegraph, const string& filename, bool keep_sids, bool lazy = false);
+
 	void save(const string& filename) const;
 
 	void print(std::ostream& out) const;
@@ -171,9 +294,16 @@ namespace storage
 	vertex_descriptor child(vertex_descriptor vertex, View view = View::CLASSIC) const;
 	vertex_descriptor parent(vertex_descriptor vertex, View view = View::CLASSIC) const;
 
-	// TODO use iterator base functions instead of vector based below
-	// boost::iterator_range<adjacency_iterator> children(vertex_descriptor vertex) const;
-	// boost::iterator_range<inv_adjacency_iterator> parents(vertex_descriptor vertex) const;
+	/**
+	 * Lazy ranges over the children, parents, in-edges and out-edges of
+	 * vertex in view. Unlike the functions returning vectors below they
+	 * do not allocate memory. The ranges are invalidated by changes of
+	 * the edges of vertex.
+	 */
+	boost::iterator_range<view_child_iterator> children_range(vertex_descriptor vertex, View view = View::CLASSIC) const;
+	boost::iterator_range<view_parent_iterator> parents_range(vertex_descriptor vertex, View view = View::CLASSIC) const;
+	boost::iterator_range<view_in_edge_iterator> in_edges_range(vertex_descriptor vertex, View view = View::CLASSIC) const;
+	boost::iterator_range<view_out_edge_iterator> out_edges_range(vertex_descriptor vertex, View view = View::CLASSIC) const;
 
 	vector<vertex_descriptor> children(vertex_descriptor vertex, View view = View::CLASSIC) const;
 	vector<vertex_descriptor> parents(vertex_descriptor vertex, View view = View::CLASSIC) const;
@@ -190,20 +320,15 @@ namespace storage
 	vector<edge_descriptor> out_edges(vertex_descriptor vertex, View view = View::CLASSIC) const;
 
 
+	/**
+	 * Get all devices of Type. Uses the per-type buckets so only devices of
+	 * Type are visited.
+	 */
 	template<typename Type>
 	vector<Type*>
 	get_devices_of_type() const
 	{
-	    vector<Type*> ret;
-
-	    for (vertex_descriptor vertex : vertices())
-	    {
-		Type* device = dynamic_cast<Type*>(graph[vertex].get());
-		if (device)
-		    ret.push_back(device);
-	    }
-
-	    return ret;
+	    return get_devices_of_type_if<Type>([](const Type* device) { return true; });
 	}
 
 
@@ -211,27 +336,43 @@ namespace storage
 	vector<Type*>
 	get_devices_of_type_if(Pred pred) const
 	{
+	    typedef typename std::remove_const<Type>::type non_const_type;
+
 	    vector<Type*> ret;
 
-	    for (vertex_descriptor vertex : vertices())
+	    if (std::is_same<non_const_type, Device>::value)
 	    {
-		Type* device = dynamic_cast<Type*>(graph[vertex].get());
-		if (device && pred(device))
-		    ret.push_back(device);
+		for (vertex_descriptor vertex : vertices())
+		{
+		    Type* device = static_cast<Type*>(graph[vertex].get());
+		    if (pred(device))
+			ret.push_back(device);
+		}
+	    }
+	    else
+	    {
+		for (vertex_descriptor vertex : vertices_of_type(DeviceTraits<non_const_type>::classname))
+		{
+		    Type* device = static_cast<Type*>(graph[vertex].get());
+		    if (pred(device))
+			ret.push_back(device);
+		}
 	    }
 
 	    return ret;
 	}
 
 
-	template <typename Type>
+	template <typename Type, typename Range>
 	vector<Type*>
-	filter_devices_of_type(const vector<vertex_descriptor>& vertices)
+	filter_devices_of_type(const Range& vertices)
 	{
 	    vector<Type*> ret;
 
 	    for (vertex_descriptor vertex : vertices)
 	    {
+		Statistics::count(Statistics::Counter::DYNAMIC_CAST);
+
 		Type* device = dynamic_cast<Type*>(graph[vertex].get());
 		if (device)
 		    ret.push_back(device);
@@ -241,14 +382,16 @@ namespace storage
 	}
 
 
-	template <typename Type>
+	template <typename Type, typename Range>
 	vector<const Type*>
-	filter_devices_of_type(const vector<vertex_descriptor>& vertices) const
+	filter_devices_of_type(const Range& vertices) const
 	{
 	    vector<const Type*> ret;
 
 	    for (vertex_descriptor vertex : vertices)
 	    {
+		Statistics::count(Statistics::Counter::DYNAMIC_CAST);
+
 		const Type* device = dynamic_cast<const Type*>(graph[vertex].get());
 		if (device)
 		    ret.push_back(device);
@@ -258,14 +401,16 @@ namespace storage
 	}
 
 
-	template <typename Type>
+	template <typename Type, typename Range>
 	vector<Type*>
-	filter_holders_of_type(const vector<edge_descriptor>& edges)
+	filter_holders_of_type(const Range& edges)
 	{
 	    vector<Type*> ret;
 
 	    for (edge_descriptor edge : edges)
 	    {
+		Statistics::count(Statistics::Counter::DYNAMIC_CAST);
+
 		Type* holder = dynamic_cast<Type*>(graph[edge].get());
 		if (holder)
 		    ret.push_back(holder);
@@ -275,14 +420,16 @@ namespace storage
 	}
 
 
-	template <typename Type>
+	template <typename Type, typename Range>
 	vector<const Type*>
-	filter_holders_of_type(const vector<edge_descriptor>& edges) const
+	filter_holders_of_type(const Range& edges) const
 	{
 	    vector<const Type*> ret;
 
 	    for (edge_descriptor edge : edges)
 	    {
+		Statistics::count(Statistics::Counter::DYNAMIC_CAST);
+
 		const Type* holder = dynamic_cast<const Type*>(graph[edge].get());
 		if (holder)
 		    ret.push_back(holder);
@@ -292,6 +439,110 @@ namespace storage
 	}
 
 
+	/**
+	 * Find the vertices of devices of Type where key_fnc returns key in
+	 * the order of vertices(). The lookup index for lookup_key and Type is
+	 * built on first use and afterwards updated when vertices are added or
+	 * removed or keys change.
+	 *
+	 * Whenever a key of a device changes set_lookup_key() must be used.
+	 */
+	template <typename Type, typename KeyFnc>
+	vector<vertex_descriptor>
+	lookup_vertices(LookupKey lookup_key, const string& key, KeyFnc key_fnc) const
+	{
+	    const lookup_index_key_t lookup_index_key(lookup_key, typeid(Type));
+
+	    vector<vertex_descriptor> ret;
+
+	    // The index is only accessed while holding the lock since
+	    // set_lookup_key() can modify it from another thread, e.g. during a
+	    // parallel commit.
+
+	    bool found = false;
+
+	    {
+		std::shared_lock<std::shared_mutex> lock(cache_mutex);
+
+		map<lookup_index_key_t, lookup_index_t>::const_iterator it = lookup_indexes.find(lookup_index_key);
+		if (it != lookup_indexes.end())
+		{
+		    it->second.find(key, ret);
+		    found = true;
+		}
+	    }
+
+	    if (!found)
+	    {
+		// The index is built while holding the exclusive lock so that
+		// no key can change meanwhile. Concurrent readers may both get
+		// here, then the second one uses the index of the first one.
+
+		std::unique_lock<std::shared_mutex> lock(cache_mutex);
+
+		map<lookup_index_key_t, lookup_index_t>::iterator it = lookup_indexes.find(lookup_index_key);
+		if (it == lookup_indexes.end())
+		    it = lookup_indexes.emplace(lookup_index_key, make_lookup_index<Type>(key_fnc)).first;
+
+		it->second.find(key, ret);
+	    }
+
+	    // Keep the order of vertices() so that with duplicate keys the same
+	    // device is found as with a linear search. Duplicates are rare so
+	    // the linear scan is acceptable here.
+	    if (ret.size() > 1)
+	    {
+		vector<vertex_descriptor> tmp;
+		tmp.reserve(ret.size());
+
+		for (vertex_descriptor vertex : vertices())
+		{
+		    if (std::find(ret.begin(), ret.end(), vertex) != ret.end())
+			tmp.push_back(vertex);
+		}
+
+		ret.swap(tmp);
+	    }
+
+	    return ret;
+	}
+
+	/**
+	 * Sets key, a key of the device of vertex used in the lookup indexes,
+	 * to value and updates the entries of vertex in the lookup indexes. Unlike other non-const
+	 * functions this function can be called while other threads use the
+	 * devicegraph, e.g. during a parallel commit.
+	 */
+	void set_lookup_key(vertex_descriptor vertex, string& key, const string& value);
+
+	/**
+	 * Hash over the content of all devices and holders and the sids of
+	 * the holders. Equal devicegraphs have equal content hashes, so
+	 * operator==() can return early if the content hashes differ. The
+	 * hash is cached until content_changed() is called.
+	 */
+	size_t get_content_hash() const;
+
+	/**
+	 * After a lazy load creates all devices and holders. Functions working
+	 * on all devices or holders call this function. Must also be called
+	 * before non-const access from several threads.
+	 */
+	void materialize_all() const { if (lazy_state) materialize_all_components(); }
+
+	/**
+	 * Marks the content hash as outdated. Called when devices or holders
+	 * are added or removed and by Device::Impl::content_changed() and
+	 * Holder::Impl::content_changed().
+	 */
+	void content_changed() const { content_hash_valid = false; }
+
+	/**
+	 * Must be called when vertices or edges are added or removed.
+	 * Invalidates the memoized relatives, see memoized_relatives().
+	 */
+	void structure_changed() { ++structure_generation; }
+
 	Storage* get_storage() { return storage; }
 	const Storage* get_storage() const { return storage; }
 
@@ -299,11 +550,275 @@ namespace storage
 
     private:
 
+	/**
+	 * Reads the file and calls fnc for the node of every device and
+	 * holder. The node is only valid during the call.
+	 */
+	static void read_xml(const string& filename, const std::function<void(bool device, const xmlNode* node)>& fnc);
+
+	void load_xml(Devicegraph* devicegraph, const string& filename);
+	void load_lazy(Devicegraph* devicegraph, const string& filename);
+
+	/**
+	 * After a lazy load creates the devices and holders of the connected
+	 * component containing the device with sid. Since components are
+	 * always created completely traversals never reach missing devices.
+	 * Functions finding devices or holders by sid call this function.
+	 */
+	void materialize(sid_t sid) const { if (lazy_state) materialize_component_of(sid); }
+
+	void materialize_component_of(sid_t sid) const;
+	void materialize_all_components() const;
+	void materialize_component(size_t component) const;
+
+	enum class Relatives { DESCENDANTS, ANCESTORS, LEAVES, ROOTS };
+
+	/**
+	 * Returns the result of fnc, the calculation of the relatives of vertex,
+	 * from a memo if available. The memo is valid until the structure of the
+	 * graph changes.
+	 */
+	template <typename Fnc>
+	vector<vertex_descriptor> memoized_relatives(Relatives relatives, vertex_descriptor vertex,
+						     bool itself, View view, Fnc fnc) const;
+
+	void load_device(Devicegraph* devicegraph, const string& classname, const xmlNode* node);
+	void load_holder(Devicegraph* devicegraph, const string& classname, const xmlNode* node);
+
 	vertex_filter_t make_vertex_filter(View view) const;
 	edge_filter_t make_edge_filter(View view) const;
 
+	/**
+	 * Rebuild all indexes from the graph. Required after the graph was
+	 * manipulated directly, e.g. by boost::copy_graph.
+	 */
+	void rebuild_indexes();
+
+	/**
+	 * Set up the indexes of this devicegraph, a fresh copy of source, by
+	 * translating the indexes of source. Cheaper than rebuild_indexes(),
+	 * e.g. no type lookups are needed, and the lookup indexes are kept.
+	 */
+	void copy_indexes(const Impl& source, const vector<vertex_descriptor>& orig_to_copy);
+
+	void full_check(const CheckCallbacks* check_callbacks) const;
+	void incremental_check(const CheckCallbacks* check_callbacks) const;
+
+	/**
+	 * Records the device with sid for the next incremental check().
+	 */
+	void mark_unchecked(sid_t sid) const;
+
+	/**
+	 * Returns the sids of the devices and the sid pairs of the holders
+	 * that differ from the copies made by the last check().
+	 */
+	void find_changed_since_check(set<sid_t>& sids, set<sid_pair_t>& sid_pairs) const;
+
+	/**
+	 * Updates the copies of the devices with sids and of the holders
+	 * with sid_pairs made for the next check(), see checked_devices.
+	 */
+	void update_checked(const set<sid_t>& sids, const set<sid_pair_t>& sid_pairs) const;
+
+	/**
+	 * Forces a full check on the next check().
+	 */
+	void invalidate_check() const;
+
+	void index_edge(edge_descriptor edge);
+	void unindex_edge(sid_pair_t sid_pair, edge_descriptor edge);
+
+	void index_vertex_for_lookup(vertex_descriptor vertex);
+	void unindex_vertex_for_lookup(vertex_descriptor vertex);
+
+	/**
+	 * Returns the vertices of devices of the type with classname (including
+	 * derived types) in the order of vertices().
+	 */
+	const vector<vertex_descriptor>& vertices_of_type(const char* classname) const;
+
+	void index_vertex_by_type(vertex_descriptor vertex);
+	void add_to_type_buckets(vertex_descriptor vertex) const;
+	void unindex_vertex_by_type(vertex_descriptor vertex);
+
+	/**
+	 * Rebuilds the type buckets if they are outdated, see
+	 * type_buckets_valid.
+	 */
+	void update_type_buckets() const;
+
+	struct lookup_index_t
+	{
+	    typedef std::unordered_multimap<string, vertex_descriptor> entries_t;
+
+	    // Returns false if the device is not of the type of the index.
+	    std::function<bool(const Device* device, string& key)> key_of;
+
+	    entries_t entries;
+
+	    void find(const string& key, vector<vertex_descriptor>& vertices) const
+	    {
+		pair<entries_t::const_iterator, entries_t::const_iterator> range = entries.equal_range(key);
+
+		for (entries_t::const_iterator it = range.first; it != range.second; ++it)
+		    vertices.push_back(it->second);
+	    }
+	};
+
+	typedef pair<LookupKey, std::type_index> lookup_index_key_t;
+
+	template <typename Type, typename KeyFnc>
+	lookup_index_t
+	make_lookup_index(KeyFnc key_fnc) const
+	{
+	    lookup_index_t lookup_index;
+
+	    lookup_index.key_of = [key_fnc](const Device* device, string& key) {
+		Statistics::count(Statistics::Counter::DYNAMIC_CAST);
+
+		const Type* tmp = dynamic_cast<const Type*>(device);
+		if (!tmp)
+		    return false;
+
+		key = key_fnc(tmp);
+		return true;
+	    };
+
+	    string key;
+
+	    for (vertex_descriptor vertex : vertices())
+	    {
+		if (lookup_index.key_of(graph[vertex].get(), key))
+		    lookup_index.entries.emplace(key, vertex);
+	    }
+
+	    return lookup_index;
+	}
+
 	Storage* storage;
 
+	struct LazyState;
+
+	/**
+	 * State of a lazy load. Reset when all devices and holders are
+	 * created.
+	 */
+	mutable std::unique_ptr<LazyState> lazy_state;
+
+	/**
+	 * Index from sid to vertex. Makes find_vertex() and device_exists() run
+	 * in constant time. Sids are unique within a devicegraph (see check()).
+	 */
+	sid_index_t sid_index;
+
+	/**
+	 * Index from the sids of source and target to edges. Makes
+	 * find_edges() and holder_exists() run in constant time. Several
+	 * edges can exist between the same source and target.
+	 */
+	sid_pair_index_t sid_pair_index;
+
+	/**
+	 * Lookup indexes, e.g. from names or uuids, to vertices. Built on
+	 * demand by lookup_vertices().
+	 */
+	mutable map<lookup_index_key_t, lookup_index_t> lookup_indexes;
+
+	/**
+	 * Buckets with the vertices of devices per classname. A device is in the
+	 * bucket of its classname and the buckets of all base types (except
+	 * Device) as listed in device_base_registry. Allows get_devices_of_type()
+	 * without dynamic_cast on every device.
+	 */
+	mutable std::unordered_map<string, vector<vertex_descriptor>> type_buckets;
+
+	/**
+	 * Within a batch removing a vertex does not update the type buckets
+	 * but marks them as outdated. They are rebuilt on the next use or at
+	 * the end of the batch.
+	 */
+	mutable std::atomic<bool> type_buckets_valid { true };
+
+	unsigned int batch_depth = 0;
+
+	/**
+	 * The vertices by their dense vertex index. On removal of a vertex
+	 * the last vertex takes over the freed index.
+	 */
+	vector<vertex_descriptor> vertices_by_index;
+
+	/**
+	 * Protects the caches filled by const functions, i.e. content_hash,
+	 * lookup_indexes, type_buckets and relatives_memo, so that const
+	 * functions can be called concurrently. Non-const functions must
+	 * not run concurrently with any other function and do not lock,
+	 * except set_lookup_key().
+	 */
+	mutable std::shared_mutex cache_mutex;
+
+	mutable size_t content_hash = 0;
+	mutable std::atomic<bool> content_hash_valid { false };
+
+	/**
+	 * Incremented whenever vertices or edges are added or removed.
+	 */
+	size_t structure_generation = 0;
+
+	typedef std::tuple<Relatives, vertex_descriptor, bool, View> relatives_memo_key_t;
+
+	/**
+	 * Memoized results of descendants(), ancestors(), leaves() and roots()
+	 * valid for relatives_memo_generation.
+	 */
+	mutable map<relatives_memo_key_t, vector<vertex_descriptor>> relatives_memo;
+	mutable size_t relatives_memo_generation = 0;
+
+	/**
+	 * Whether a full check() succeeded and all changes of the structure
+	 * since then are recorded in unchecked_sids and unchecked_sid_pairs.
+	 */
+	mutable bool check_valid = false;
+
+	/**
+	 * Serializes concurrent calls of check().
+	 */
+	mutable std::mutex check_mutex;
+
+	/**
+	 * Devices added, and neighbours of devices and holders added or
+	 * removed, since the last successful check().
+	 */
+	mutable std::unordered_set<sid_t> unchecked_sids;
+
+	/**
+	 * Holders added since the last successful check(). Only these can
+	 * have introduced a cycle.
+	 */
+	mutable vector<sid_pair_t> unchecked_sid_pairs;
+
+	/**
+	 * Devices that reported errors via the check callbacks during the
+	 * last check() with check callbacks.
+	 */
+	mutable std::unordered_set<sid_t> sids_with_check_errors;
+
+	/**
+	 * Whether the last full check() had check callbacks. Otherwise
+	 * sids_with_check_errors is unknown and the next check() with check
+	 * callbacks must be a full check.
+	 */
+	mutable bool check_errors_known = false;
+
+	/**
+	 * Copies of the devices and holders made by the last successful
+	 * check(). The next check() compares the devices and holders with
+	 * the copies to find the changed ones. Unlike recording
+	 * modifications this cannot miss any.
+	 */
+	mutable map<sid_t, std::shared_ptr<const Device>> checked_devices;
+	mutable map<sid_pair_t, vector<std::shared_ptr<const Holder>>> checked_holders;
+
     };
 
 }
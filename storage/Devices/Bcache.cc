@@ -54,7 +54,7 @@ namespace storage
     Bcache*
     Bcache::create(Devicegraph* devicegraph, const string& name, BcacheType type)
     {
-	shared_ptr<Bcache> bcache = make_shared<Bcache>(make_unique<Bcache::Impl>(name, type));
+	shared_ptr<Bcache> bcache = make_pooled<Bcache>(make_unique<Bcache::Impl>(name, type));
 	Device::Impl::create(devicegraph, bcache);
 	return bcache.get();
     }
@@ -63,7 +63,7 @@ namespace storage
     Bcache*
     Bcache::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<Bcache> bcache = make_shared<Bcache>(make_unique<Bcache::Impl>(node));
+	shared_ptr<Bcache> bcache = make_pooled<Bcache>(make_unique<Bcache::Impl>(node));
 	Device::Impl::load(devicegraph, bcache);
 	return bcache.get();
     }
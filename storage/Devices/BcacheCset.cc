@@ -34,7 +34,7 @@ namespace storage
     BcacheCset*
     BcacheCset::create(Devicegraph* devicegraph)
     {
-	shared_ptr<BcacheCset> bcache_cset = make_shared<BcacheCset>(make_unique<BcacheCset::Impl>());
+	shared_ptr<BcacheCset> bcache_cset = make_pooled<BcacheCset>(make_unique<BcacheCset::Impl>());
 	Device::Impl::create(devicegraph, bcache_cset);
 	return bcache_cset.get();
     }
@@ -43,7 +43,7 @@ namespace storage
     BcacheCset*
     BcacheCset::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<BcacheCset> bcache_cset = make_shared<BcacheCset>(make_unique<BcacheCset::Impl>(node));
+	shared_ptr<BcacheCset> bcache_cset = make_pooled<BcacheCset>(make_unique<BcacheCset::Impl>(node));
 	Device::Impl::load(devicegraph, bcache_cset);
 	return bcache_cset.get();
     }
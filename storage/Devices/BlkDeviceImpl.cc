@@ -122,6 +122,8 @@ namespace storage
 		udev_ids = cmd_udevadm_info.get_by_id_links();
 		process_udev_ids(udev_ids, prober.get_udev_filters());
 	    }
+
+	    content_changed();
 	}
     }
 
@@ -201,7 +203,7 @@ namespace storage
     void
     BlkDevice::Impl::set_name(const string& name)
     {
-	Impl::name = name;
+	set_lookup_key(Impl::name, name);
     }
 
 
@@ -210,6 +212,8 @@ namespace storage
     {
 	Impl::region = region;
 
+	content_changed();
+
 	for (Device* child : get_non_impl()->get_children())
 	    child->get_impl().parent_has_new_region(get_non_impl());
     }
@@ -665,6 +669,29 @@ namespace storage
     }
 
 
+    void
+    BlkDevice::Impl::add_to_content_hash(size_t& seed) const
+    {
+	Device::Impl::add_to_content_hash(seed);
+
+	boost::hash_combine(seed, name);
+	boost::hash_combine(seed, sysfs_name);
+	boost::hash_combine(seed, sysfs_path);
+
+	boost::hash_combine(seed, region.get_start());
+	boost::hash_combine(seed, region.get_length());
+	boost::hash_combine(seed, region.get_block_size(ULL_HACK));
+
+	boost::hash_combine(seed, active);
+	boost::hash_combine(seed, read_only);
+
+	boost::hash_combine(seed, udev_paths);
+	boost::hash_combine(seed, udev_ids);
+
+	boost::hash_combine(seed, dm_table_name);
+    }
+
+
     void
     BlkDevice::Impl::log_diff(std::ostream& log, const Device::Impl& rhs_base) const
     {
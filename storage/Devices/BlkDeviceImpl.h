@@ -70,10 +70,10 @@ namespace storage
 	virtual void set_name(const string& name);
 
 	const string& get_sysfs_name() const { return sysfs_name; }
-	void set_sysfs_name(const string& sysfs_name) { Impl::sysfs_name = sysfs_name; }
+	void set_sysfs_name(const string& sysfs_name) { Impl::sysfs_name = sysfs_name; content_changed(); }
 
 	const string& get_sysfs_path() const { return sysfs_path; }
-	void set_sysfs_path(const string& sysfs_path) { Impl::sysfs_path = sysfs_path; }
+	void set_sysfs_path(const string& sysfs_path) { Impl::sysfs_path = sysfs_path; content_changed(); }
 
 	const File& get_sysfs_file(SystemInfo::Impl& system_info, const char* filename) const;
 
@@ -86,7 +86,7 @@ namespace storage
 	virtual vector<MountByType> possible_mount_bys() const;
 
 	bool is_active() const { return active; }
-	void set_active(bool active) { Impl::active = active; }
+	void set_active(bool active) { Impl::active = active; content_changed(); }
 
 	bool is_read_only() const { return read_only; }
 
@@ -102,10 +102,10 @@ namespace storage
 	void set_topology(const Topology& topology) { Impl::topology = topology; }
 
 	const vector<string>& get_udev_paths() const { return udev_paths; }
-	void set_udev_paths(const vector<string>& udev_paths) { Impl::udev_paths = udev_paths; }
+	void set_udev_paths(const vector<string>& udev_paths) { Impl::udev_paths = udev_paths; content_changed(); }
 
 	const vector<string>& get_udev_ids() const { return udev_ids; }
-	void set_udev_ids(const vector<string>& udev_ids) { Impl::udev_ids = udev_ids; }
+	void set_udev_ids(const vector<string>& udev_ids) { Impl::udev_ids = udev_ids; content_changed(); }
 
 	virtual string get_fstab_spec(MountByType mount_by_type) const;
 
@@ -117,7 +117,7 @@ namespace storage
 	virtual bool spec_match(SystemInfo::Impl& system_info, const string& spec) const;
 
 	const string& get_dm_table_name() const { return dm_table_name; }
-	virtual void set_dm_table_name(const string& dm_table_name) { Impl::dm_table_name = dm_table_name; }
+	virtual void set_dm_table_name(const string& dm_table_name) { Impl::dm_table_name = dm_table_name; content_changed(); }
 
 	static bool is_valid_dm_table_name(const string& dm_table_name);
 
@@ -213,6 +213,8 @@ namespace storage
 
 	virtual void save(xmlNode* node) const override;
 
+	virtual void add_to_content_hash(size_t& seed) const override;
+
     private:
 
 	string name;
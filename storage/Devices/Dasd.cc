@@ -50,7 +50,7 @@ namespace storage
     Dasd*
     Dasd::create(Devicegraph* devicegraph, const string& name)
     {
-	shared_ptr<Dasd> dasd = make_shared<Dasd>(make_unique<Dasd::Impl>(name));
+	shared_ptr<Dasd> dasd = make_pooled<Dasd>(make_unique<Dasd::Impl>(name));
 	Device::Impl::create(devicegraph, dasd);
 	return dasd.get();
     }
@@ -59,7 +59,7 @@ namespace storage
     Dasd*
     Dasd::create(Devicegraph* devicegraph, const string& name, const Region& region)
     {
-	shared_ptr<Dasd> dasd = make_shared<Dasd>(make_unique<Dasd::Impl>(name, region));
+	shared_ptr<Dasd> dasd = make_pooled<Dasd>(make_unique<Dasd::Impl>(name, region));
 	Device::Impl::create(devicegraph, dasd);
 	return dasd.get();
     }
@@ -68,7 +68,7 @@ namespace storage
     Dasd*
     Dasd::create(Devicegraph* devicegraph, const string& name, unsigned long long size)
     {
-	shared_ptr<Dasd> dasd = make_shared<Dasd>(make_unique<Dasd::Impl>(name, Region(0, size / 512, 512)));
+	shared_ptr<Dasd> dasd = make_pooled<Dasd>(make_unique<Dasd::Impl>(name, Region(0, size / 512, 512)));
 	Device::Impl::create(devicegraph, dasd);
 	return dasd.get();
     }
@@ -77,7 +77,7 @@ namespace storage
     Dasd*
     Dasd::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<Dasd> dasd = make_shared<Dasd>(make_unique<Dasd::Impl>(node));
+	shared_ptr<Dasd> dasd = make_pooled<Dasd>(make_unique<Dasd::Impl>(node));
 	Device::Impl::load(devicegraph, dasd);
 	return dasd.get();
     }
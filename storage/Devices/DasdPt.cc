@@ -34,7 +34,7 @@ namespace storage
     DasdPt*
     DasdPt::create(Devicegraph* devicegraph)
     {
-	shared_ptr<DasdPt> dasd_pt = make_shared<DasdPt>(make_unique<DasdPt::Impl>());
+	shared_ptr<DasdPt> dasd_pt = make_pooled<DasdPt>(make_unique<DasdPt::Impl>());
 	Device::Impl::create(devicegraph, dasd_pt);
 	return dasd_pt.get();
     }
@@ -43,7 +43,7 @@ namespace storage
     DasdPt*
     DasdPt::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<DasdPt> dasd_pt = make_shared<DasdPt>(make_unique<DasdPt::Impl>(node));
+	shared_ptr<DasdPt> dasd_pt = make_pooled<DasdPt>(make_unique<DasdPt::Impl>(node));
 	Device::Impl::load(devicegraph, dasd_pt);
 	return dasd_pt.get();
     }
@@ -221,7 +221,7 @@ namespace storage
 	Devicegraph* devicegraph = get_impl().get_devicegraph();
 	Devicegraph::Impl::vertex_descriptor vertex = get_impl().get_vertex();
 
-	return devicegraph->get_impl().filter_devices_of_type<Device>(devicegraph->get_impl().children(vertex, view));
+	return devicegraph->get_impl().filter_devices_of_type<Device>(devicegraph->get_impl().children_range(vertex, view));
     }
 
 
@@ -231,7 +231,7 @@ namespace storage
 	const Devicegraph* devicegraph = get_impl().get_devicegraph();
 	Devicegraph::Impl::vertex_descriptor vertex = get_impl().get_vertex();
 
-	return devicegraph->get_impl().filter_devices_of_type<Device>(devicegraph->get_impl().children(vertex, view));
+	return devicegraph->get_impl().filter_devices_of_type<Device>(devicegraph->get_impl().children_range(vertex, view));
     }
 
 
@@ -255,7 +255,7 @@ namespace storage
 	Devicegraph* devicegraph = get_impl().get_devicegraph();
 	Devicegraph::Impl::vertex_descriptor vertex = get_impl().get_vertex();
 
-	return devicegraph->get_impl().filter_devices_of_type<Device>(devicegraph->get_impl().parents(vertex, view));
+	return devicegraph->get_impl().filter_devices_of_type<Device>(devicegraph->get_impl().parents_range(vertex, view));
     }
 
 
@@ -265,7 +265,7 @@ namespace storage
 	const Devicegraph* devicegraph = get_impl().get_devicegraph();
 	Devicegraph::Impl::vertex_descriptor vertex = get_impl().get_vertex();
 
-	return devicegraph->get_impl().filter_devices_of_type<Device>(devicegraph->get_impl().parents(vertex, view));
+	return devicegraph->get_impl().filter_devices_of_type<Device>(devicegraph->get_impl().parents_range(vertex, view));
     }
 
 
@@ -389,7 +389,7 @@ namespace storage
 	Devicegraph* devicegraph = get_impl().get_devicegraph();
 	Devicegraph::Impl::vertex_descriptor vertex = get_impl().get_vertex();
 
-	return devicegraph->get_impl().filter_holders_of_type<Holder>(devicegraph->get_impl().in_edges(vertex));
+	return devicegraph->get_impl().filter_holders_of_type<Holder>(devicegraph->get_impl().in_edges_range(vertex));
     }
 
 
@@ -399,7 +399,7 @@ namespace storage
 	const Devicegraph* devicegraph = get_impl().get_devicegraph();
 	Devicegraph::Impl::vertex_descriptor vertex = get_impl().get_vertex();
 
-	return devicegraph->get_impl().filter_holders_of_type<Holder>(devicegraph->get_impl().in_edges(vertex));
+	return devicegraph->get_impl().filter_holders_of_type<Holder>(devicegraph->get_impl().in_edges_range(vertex));
     }
 
 
@@ -409,7 +409,7 @@ namespace storage
 	Devicegraph* devicegraph = get_impl().get_devicegraph();
 	Devicegraph::Impl::vertex_descriptor vertex = get_impl().get_vertex();
 
-	return devicegraph->get_impl().filter_holders_of_type<Holder>(devicegraph->get_impl().out_edges(vertex));
+	return devicegraph->get_impl().filter_holders_of_type<Holder>(devicegraph->get_impl().out_edges_range(vertex));
     }
 
 
@@ -419,7 +419,7 @@ namespace storage
 	const Devicegraph* devicegraph = get_impl().get_devicegraph();
 	Devicegraph::Impl::vertex_descriptor vertex = get_impl().get_vertex();
 
-	return devicegraph->get_impl().filter_holders_of_type<Holder>(devicegraph->get_impl().out_edges(vertex));
+	return devicegraph->get_impl().filter_holders_of_type<Holder>(devicegraph->get_impl().out_edges_range(vertex));
     }
 
 
@@ -76,10 +76,11 @@ namespace storage
 	if (exists_in_devicegraph(devicegraph))
 	    ST_THROW(Exception(sformat("device already exists, sid:%d", get_sid())));
 
-	shared_ptr<Device> device = get_non_impl()->clone_v2();
+	shared_ptr<Device> device = to_pooled(get_non_impl()->clone_v2());
 
 	Devicegraph::Impl::vertex_descriptor vertex = devicegraph->get_impl().add_vertex_v2(device);
 	device->get_impl().set_devicegraph_and_vertex(devicegraph, vertex);
+	device->get_impl().copy_content_state(*this);
 
 	return device.get();
     }
@@ -166,6 +167,41 @@ namespace storage
     }
 
 
+    void
+    Device::Impl::set_sid(sid_t sid)
+    {
+	sid_t old_sid = Impl::sid;
+
+	Impl::sid = sid;
+
+	content_changed();
+
+	if (devicegraph)
+	    devicegraph->get_impl().sid_changed(vertex, old_sid);
+    }
+
+
+    void
+    Device::Impl::set_lookup_key(string& key, const string& value)
+    {
+	if (devicegraph)
+	    devicegraph->get_impl().set_lookup_key(vertex, key, value);
+	else
+	    key = value;
+
+	content_changed();
+    }
+
+
+    void
+    Device::Impl::set_userdata(const map<string, string>& userdata)
+    {
+	Impl::userdata = userdata;
+
+	content_changed();
+    }
+
+
     void
     Device::Impl::set_devicegraph_and_vertex(Devicegraph* devicegraph,
 					     Devicegraph::Impl::vertex_descriptor vertex)
@@ -245,8 +281,7 @@ namespace storage
     {
 	Devicegraph::Impl& devicegraph_impl = devicegraph->get_impl();
 
-	for (Devicegraph::Impl::vertex_descriptor descendant : devicegraph_impl.descendants(vertex, false, view))
-	    devicegraph_impl.remove_vertex(descendant);
+	devicegraph_impl.remove_vertices(devicegraph_impl.descendants(vertex, false, view));
     }
 
 
@@ -347,6 +382,51 @@ namespace storage
     }
 
 
+    size_t
+    Device::Impl::get_content_hash() const
+    {
+	if (!content_hash_valid)
+	{
+	    size_t seed = 0;
+	    add_to_content_hash(seed);
+
+	    content_hash = seed;
+	    content_hash_valid = true;
+	}
+
+	return content_hash;
+    }
+
+
+    void
+    Device::Impl::content_changed() const
+    {
+	content_hash_valid = false;
+
+	if (devicegraph)
+	    devicegraph->get_impl().content_changed();
+    }
+
+
+    void
+    Device::Impl::copy_content_state(const Impl& source)
+    {
+	content_hash = source.content_hash;
+	content_hash_valid = source.content_hash_valid;
+    }
+
+
+    void
+    Device::Impl::add_to_content_hash(size_t& seed) const
+    {
+	// equal() is only called for devices of the same type
+	boost::hash_combine(seed, string(get_classname()));
+
+	boost::hash_combine(seed, sid);
+	boost::hash_combine(seed, userdata);
+    }
+
+
     void
     Device::Impl::log_diff(std::ostream& log, const Impl& rhs) const
     {
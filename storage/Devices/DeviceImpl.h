@@ -30,6 +30,7 @@
 
 #include "storage/Utils/AppUtil.h"
 #include "storage/Utils/ExceptionImpl.h"
+#include "storage/Utils/ObjectPool.h"
 #include "storage/Devices/Device.h"
 #include "storage/Holders/HolderImpl.h"
 #include "storage/Devicegraph.h"
@@ -71,6 +72,9 @@ namespace storage
 
 	virtual ~Impl() = default;
 
+	static void* operator new(size_t size) { return ObjectPool::allocate(size); }
+	static void operator delete(void* ptr, size_t size) noexcept { ObjectPool::deallocate(ptr, size); }
+
 	virtual unique_ptr<Impl> clone() const = 0;
 
 	virtual const char* get_classname() const = 0;
@@ -101,7 +105,14 @@ namespace storage
 	const Storage* get_storage() const;
 
 	sid_t get_sid() const { return sid; }
-	void set_sid(sid_t sid) { Impl::sid = sid; }
+	void set_sid(sid_t sid);
+
+	/**
+	 * Sets key, a member used in the lookup indexes of the devicegraph,
+	 * e.g. the name or uuid, to value. Must be used whenever such a key
+	 * changes.
+	 */
+	void set_lookup_key(string& key, const string& value);
 
 	void set_devicegraph_and_vertex(Devicegraph* devicegraph,
 					Devicegraph::Impl::vertex_descriptor vertex);
@@ -119,7 +130,7 @@ namespace storage
 	bool has_any_active_descendants() const;
 
 	const map<string, string>& get_userdata() const { return userdata; }
-	void set_userdata(const map<string, string>& userdata) { Impl::userdata = userdata; }
+	void set_userdata(const map<string, string>& userdata);
 
 	virtual void probe_pass_1a(Prober& prober);
 	virtual void probe_pass_1b(Prober& prober);
@@ -162,6 +173,27 @@ namespace storage
 	virtual void log_diff(std::ostream& log, const Impl& rhs) const = 0;
 	virtual void print(std::ostream& out) const = 0;
 
+	/**
+	 * Hash over the content of the device compared by equal(). Equal
+	 * devices have equal content hashes, so different content hashes
+	 * imply different devices. The hash is cached until
+	 * content_changed() is called.
+	 */
+	size_t get_content_hash() const;
+
+	/**
+	 * Marks the content hash of the device and of its devicegraph as
+	 * outdated. Called by the setters of the members added to the
+	 * content hash, see add_to_content_hash().
+	 */
+	void content_changed() const;
+
+	/**
+	 * Takes over the content hash of source. Only allowed if
+	 * this device is an unmodified clone of source.
+	 */
+	void copy_content_state(const Impl& source);
+
 	virtual Text do_create_text(Tense tense) const;
 	virtual void do_create();
 	virtual void do_create_post_verify() const;
@@ -241,7 +273,17 @@ namespace storage
 
 	    const Devicegraph::Impl& devicegraph_impl = get_devicegraph()->get_impl();
 
-	    return devicegraph_impl.filter_devices_of_type<Type>(devicegraph_impl.children(get_vertex(), view)).size();
+	    size_t ret = 0;
+
+	    for (Devicegraph::Impl::vertex_descriptor child : devicegraph_impl.children_range(get_vertex(), view))
+	    {
+		Statistics::count(Statistics::Counter::DYNAMIC_CAST);
+
+		if (dynamic_cast<Type*>(devicegraph_impl[child]))
+		    ++ret;
+	    }
+
+	    return ret;
 	}
 
 	template<typename Type>
@@ -251,7 +293,7 @@ namespace storage
 
 	    Devicegraph::Impl& devicegraph_impl = get_devicegraph()->get_impl();
 
-	    return devicegraph_impl.filter_devices_of_type<Type>(devicegraph_impl.children(get_vertex(), view));
+	    return devicegraph_impl.filter_devices_of_type<Type>(devicegraph_impl.children_range(get_vertex(), view));
 	}
 
 	template<typename Type>
@@ -261,7 +303,7 @@ namespace storage
 
 	    const Devicegraph::Impl& devicegraph_impl = get_devicegraph()->get_impl();
 
-	    return devicegraph_impl.filter_devices_of_type<Type>(devicegraph_impl.children(get_vertex(), view));
+	    return devicegraph_impl.filter_devices_of_type<Type>(devicegraph_impl.children_range(get_vertex(), view));
 	}
 
 
@@ -311,7 +353,7 @@ namespace storage
 
 	    Devicegraph::Impl& devicegraph_impl = get_devicegraph()->get_impl();
 
-	    return devicegraph_impl.filter_devices_of_type<Type>(devicegraph_impl.parents(get_vertex(), view));
+	    return devicegraph_impl.filter_devices_of_type<Type>(devicegraph_impl.parents_range(get_vertex(), view));
 	}
 
 	template<typename Type>
@@ -321,7 +363,7 @@ namespace storage
 
 	    const Devicegraph::Impl& devicegraph_impl = get_devicegraph()->get_impl();
 
-	    return devicegraph_impl.filter_devices_of_type<Type>(devicegraph_impl.parents(get_vertex(), view));
+	    return devicegraph_impl.filter_devices_of_type<Type>(devicegraph_impl.parents_range(get_vertex(), view));
 	}
 
 	template<typename Type>
@@ -331,7 +373,7 @@ namespace storage
 
 	    Devicegraph::Impl& devicegraph_impl = get_devicegraph()->get_impl();
 
-	    return devicegraph_impl.filter_holders_of_type<Type>(devicegraph_impl.in_edges(get_vertex(), view));
+	    return devicegraph_impl.filter_holders_of_type<Type>(devicegraph_impl.in_edges_range(get_vertex(), view));
 	}
 
 	template<typename Type>
@@ -341,7 +383,7 @@ namespace storage
 
 	    const Devicegraph::Impl& devicegraph_impl = get_devicegraph()->get_impl();
 
-	    return devicegraph_impl.filter_holders_of_type<Type>(devicegraph_impl.in_edges(get_vertex(), view));
+	    return devicegraph_impl.filter_holders_of_type<Type>(devicegraph_impl.in_edges_range(get_vertex(), view));
 	}
 
 	template<typename Type>
@@ -351,7 +393,7 @@ namespace storage
 
 	    Devicegraph::Impl& devicegraph_impl = get_devicegraph()->get_impl();
 
-	    return devicegraph_impl.filter_holders_of_type<Type>(devicegraph_impl.out_edges(get_vertex(), view));
+	    return devicegraph_impl.filter_holders_of_type<Type>(devicegraph_impl.out_edges_range(get_vertex(), view));
 	}
 
 	template<typename Type>
@@ -361,7 +403,7 @@ namespace storage
 
 	    const Devicegraph::Impl& devicegraph_impl = get_devicegraph()->get_impl();
 
-	    return devicegraph_impl.filter_holders_of_type<Type>(devicegraph_impl.out_edges(get_vertex(), view));
+	    return devicegraph_impl.filter_holders_of_type<Type>(devicegraph_impl.out_edges_range(get_vertex(), view));
 	}
 
 	template<typename Type>
@@ -395,6 +437,14 @@ namespace storage
 
 	Impl(const xmlNode* node);
 
+	/**
+	 * Adds the content of the device to the content hash. Derived classes
+	 * may only add content also compared by their equal() function but do
+	 * not need to add all of it. Only private members may be added and
+	 * everything changing them must call content_changed().
+	 */
+	virtual void add_to_content_hash(size_t& seed) const;
+
     public:
 
 	/**
@@ -425,6 +475,9 @@ namespace storage
 
 	map<string, string> userdata;
 
+	mutable size_t content_hash = 0;
+	mutable bool content_hash_valid = false;
+
     };
 
 
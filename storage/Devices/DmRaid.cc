@@ -33,7 +33,7 @@ namespace storage
     DmRaid*
     DmRaid::create(Devicegraph* devicegraph, const string& name)
     {
-	shared_ptr<DmRaid> dm_raid = make_shared<DmRaid>(make_unique<DmRaid::Impl>(name));
+	shared_ptr<DmRaid> dm_raid = make_pooled<DmRaid>(make_unique<DmRaid::Impl>(name));
 	Device::Impl::create(devicegraph, dm_raid);
 	return dm_raid.get();
     }
@@ -42,7 +42,7 @@ namespace storage
     DmRaid*
     DmRaid::create(Devicegraph* devicegraph, const string& name, const Region& region)
     {
-	shared_ptr<DmRaid> dm_raid = make_shared<DmRaid>(make_unique<DmRaid::Impl>(name, region));
+	shared_ptr<DmRaid> dm_raid = make_pooled<DmRaid>(make_unique<DmRaid::Impl>(name, region));
 	Device::Impl::create(devicegraph, dm_raid);
 	return dm_raid.get();
     }
@@ -51,7 +51,7 @@ namespace storage
     DmRaid*
     DmRaid::create(Devicegraph* devicegraph, const string& name, unsigned long long size)
     {
-	shared_ptr<DmRaid> dm_raid = make_shared<DmRaid>(make_unique<DmRaid::Impl>(name, Region(0, size / 512, 512)));
+	shared_ptr<DmRaid> dm_raid = make_pooled<DmRaid>(make_unique<DmRaid::Impl>(name, Region(0, size / 512, 512)));
 	Device::Impl::create(devicegraph, dm_raid);
 	return dm_raid.get();
     }
@@ -60,7 +60,7 @@ namespace storage
     DmRaid*
     DmRaid::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<DmRaid> dm_raid = make_shared<DmRaid>(make_unique<DmRaid::Impl>(node));
+	shared_ptr<DmRaid> dm_raid = make_pooled<DmRaid>(make_unique<DmRaid::Impl>(node));
 	Device::Impl::load(devicegraph, dm_raid);
 	return dm_raid.get();
     }
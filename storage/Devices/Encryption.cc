@@ -40,7 +40,7 @@ namespace storage
     Encryption*
     Encryption::create(Devicegraph* devicegraph, const string& dm_table_name)
     {
-	shared_ptr<Encryption> encryption = make_shared<Encryption>(make_unique<Encryption::Impl>(dm_table_name));
+	shared_ptr<Encryption> encryption = make_pooled<Encryption>(make_unique<Encryption::Impl>(dm_table_name));
 	Device::Impl::create(devicegraph, encryption);
 	return encryption.get();
     }
@@ -49,7 +49,7 @@ namespace storage
     Encryption*
     Encryption::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<Encryption> encryption = make_shared<Encryption>(make_unique<Encryption::Impl>(node));
+	shared_ptr<Encryption> encryption = make_pooled<Encryption>(make_unique<Encryption::Impl>(node));
 	Device::Impl::load(devicegraph, encryption);
 	return encryption.get();
     }
@@ -600,8 +600,8 @@ namespace storage
 	entry->set_crypt_opts(get_crypt_options());
 
 	etc_crypttab.add(entry);
-	etc_crypttab.log();
-	etc_crypttab.write();
+
+	commit_data.set_etc_crypttab_dirty();
     }
 
 
@@ -635,8 +635,8 @@ namespace storage
 	if (entry)
 	{
 	    entry->set_block_device(get_crypttab_spec(get_mount_by()));
-	    etc_crypttab.log();
-	    etc_crypttab.write();
+
+	    commit_data.set_etc_crypttab_dirty();
 	}
     }
 
@@ -665,8 +665,8 @@ namespace storage
 	if (entry)
 	{
 	    etc_crypttab.remove(entry);
-	    etc_crypttab.log();
-	    etc_crypttab.write();
+
+	    commit_data.set_etc_crypttab_dirty();
 	}
     }
 
@@ -34,7 +34,7 @@ namespace storage
     Gpt*
     Gpt::create(Devicegraph* devicegraph)
     {
-	shared_ptr<Gpt> gpt = make_shared<Gpt>(make_unique<Gpt::Impl>());
+	shared_ptr<Gpt> gpt = make_pooled<Gpt>(make_unique<Gpt::Impl>());
 	Device::Impl::create(devicegraph, gpt);
 	return gpt.get();
     }
@@ -43,7 +43,7 @@ namespace storage
     Gpt*
     Gpt::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<Gpt> gpt = make_shared<Gpt>(make_unique<Gpt::Impl>(node));
+	shared_ptr<Gpt> gpt = make_pooled<Gpt>(make_unique<Gpt::Impl>(node));
 	Device::Impl::load(devicegraph, gpt);
 	return gpt.get();
     }
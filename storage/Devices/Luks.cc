@@ -33,7 +33,7 @@ namespace storage
     Luks*
     Luks::create(Devicegraph* devicegraph, const string& dm_table_name)
     {
-	shared_ptr<Luks> luks = make_shared<Luks>(make_unique<Luks::Impl>(dm_table_name));
+	shared_ptr<Luks> luks = make_pooled<Luks>(make_unique<Luks::Impl>(dm_table_name));
 	Device::Impl::create(devicegraph, luks);
 	return luks.get();
     }
@@ -42,7 +42,7 @@ namespace storage
     Luks*
     Luks::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<Luks> luks = make_shared<Luks>(make_unique<Luks::Impl>(node));
+	shared_ptr<Luks> luks = make_pooled<Luks>(make_unique<Luks::Impl>(node));
 	Device::Impl::load(devicegraph, luks);
 	return luks.get();
     }
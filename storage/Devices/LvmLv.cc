@@ -60,7 +60,7 @@ namespace storage
     LvmLv::create(Devicegraph* devicegraph, const string& vg_name, const string& lv_name,
 		  LvType lv_type)
     {
-	shared_ptr<LvmLv> lvm_lv = make_shared<LvmLv>(make_unique<LvmLv::Impl>(vg_name, lv_name, lv_type));
+	shared_ptr<LvmLv> lvm_lv = make_pooled<LvmLv>(make_unique<LvmLv::Impl>(vg_name, lv_name, lv_type));
 	Device::Impl::create(devicegraph, lvm_lv);
 	return lvm_lv.get();
     }
@@ -69,7 +69,7 @@ namespace storage
     LvmLv*
     LvmLv::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<LvmLv> lvm_lv = make_shared<LvmLv>(make_unique<LvmLv::Impl>(node));
+	shared_ptr<LvmLv> lvm_lv = make_pooled<LvmLv>(make_unique<LvmLv::Impl>(node));
 	Device::Impl::load(devicegraph, lvm_lv);
 	return lvm_lv.get();
     }
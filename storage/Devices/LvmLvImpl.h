@@ -97,7 +97,7 @@ namespace storage
 	LvType get_lv_type() const { return lv_type; }
 
 	const string& get_uuid() const { return uuid; }
-	void set_uuid(const string& uuid) { Impl::uuid = uuid; }
+	void set_uuid(const string& uuid) { set_lookup_key(Impl::uuid, uuid); }
 
 	virtual void set_region(const Region& region) override;
 
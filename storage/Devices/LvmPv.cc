@@ -34,7 +34,7 @@ namespace storage
     LvmPv*
     LvmPv::create(Devicegraph* devicegraph)
     {
-	shared_ptr<LvmPv> lvm_pv = make_shared<LvmPv>(make_unique<LvmPv::Impl>());
+	shared_ptr<LvmPv> lvm_pv = make_pooled<LvmPv>(make_unique<LvmPv::Impl>());
 	Device::Impl::create(devicegraph, lvm_pv);
 	return lvm_pv.get();
     }
@@ -43,7 +43,7 @@ namespace storage
     LvmPv*
     LvmPv::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<LvmPv> lvm_pv = make_shared<LvmPv>(make_unique<LvmPv::Impl>(node));
+	shared_ptr<LvmPv> lvm_pv = make_pooled<LvmPv>(make_unique<LvmPv::Impl>(node));
 	Device::Impl::load(devicegraph, lvm_pv);
 	return lvm_pv.get();
     }
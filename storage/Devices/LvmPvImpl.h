@@ -62,7 +62,7 @@ namespace storage
 	virtual void check(const CheckCallbacks* check_callbacks) const override;
 
 	const string& get_uuid() const { return uuid; }
-	void set_uuid(const string& uuid) { Impl::uuid = uuid; }
+	void set_uuid(const string& uuid) { set_lookup_key(Impl::uuid, uuid); }
 
 	bool has_blk_device() const;
 
@@ -99,7 +99,7 @@ namespace storage
 	static bool is_valid_vg_name(const string& vg_name);
 
 	const string& get_uuid() const { return uuid; }
-	void set_uuid(const string& uuid) { Impl::uuid = uuid; }
+	void set_uuid(const string& uuid) { set_lookup_key(Impl::uuid, uuid); }
 
 	LvmPv* add_lvm_pv(BlkDevice* blk_device);
 	void remove_lvm_pv(BlkDevice* blk_device);
@@ -51,7 +51,7 @@ namespace storage
     Md*
     Md::create(Devicegraph* devicegraph, const string& name)
     {
-	shared_ptr<Md> md = make_shared<Md>(make_unique<Md::Impl>(name));
+	shared_ptr<Md> md = make_pooled<Md>(make_unique<Md::Impl>(name));
 	Device::Impl::create(devicegraph, md);
 	return md.get();
     }
@@ -60,7 +60,7 @@ namespace storage
     Md*
     Md::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<Md> md = make_shared<Md>(make_unique<Md::Impl>(node));
+	shared_ptr<Md> md = make_pooled<Md>(make_unique<Md::Impl>(node));
 	Device::Impl::load(devicegraph, md);
 	return md.get();
     }
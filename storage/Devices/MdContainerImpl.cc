@@ -114,7 +114,8 @@ namespace storage
 	entry.uuid = get_uuid();
 	entry.metadata = get_metadata();
 
-	etc_mdadm.update_entry(entry);
+	if (etc_mdadm.update_entry(entry))
+	    commit_data.set_etc_mdadm_dirty();
     }
 
 
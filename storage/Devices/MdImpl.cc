@@ -1397,7 +1397,8 @@ namespace storage
 	entry.device = get_name();
 	entry.uuid = uuid;
 
-	etc_mdadm.update_entry(entry);
+	if (etc_mdadm.update_entry(entry))
+	    commit_data.set_etc_mdadm_dirty();
     }
 
 
@@ -1423,7 +1424,8 @@ namespace storage
 
 	// TODO containers?
 
-	etc_mdadm.remove_entry(uuid);
+	if (etc_mdadm.remove_entry(uuid))
+	    commit_data.set_etc_mdadm_dirty();
     }
 
 
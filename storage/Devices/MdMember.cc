@@ -33,7 +33,7 @@ namespace storage
     MdMember*
     MdMember::create(Devicegraph* devicegraph, const string& name)
     {
-	shared_ptr<MdMember> md_member = make_shared<MdMember>(make_unique<MdMember::Impl>(name));
+	shared_ptr<MdMember> md_member = make_pooled<MdMember>(make_unique<MdMember::Impl>(name));
 	Device::Impl::create(devicegraph, md_member);
 	return md_member.get();
     }
@@ -42,7 +42,7 @@ namespace storage
     MdMember*
     MdMember::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<MdMember> md_member = make_shared<MdMember>(make_unique<MdMember::Impl>(node));
+	shared_ptr<MdMember> md_member = make_pooled<MdMember>(make_unique<MdMember::Impl>(node));
 	Device::Impl::load(devicegraph, md_member);
 	return md_member.get();
     }
@@ -162,7 +162,8 @@ namespace storage
 	entry.container_uuid = md_container->get_uuid();
 	entry.container_member = md_subdevice->get_member();
 
-	etc_mdadm.update_entry(entry);
+	if (etc_mdadm.update_entry(entry))
+	    commit_data.set_etc_mdadm_dirty();
     }
 
 
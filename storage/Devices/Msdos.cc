@@ -34,7 +34,7 @@ namespace storage
     Msdos*
     Msdos::create(Devicegraph* devicegraph)
     {
-	shared_ptr<Msdos> msdos = make_shared<Msdos>(make_unique<Msdos::Impl>());
+	shared_ptr<Msdos> msdos = make_pooled<Msdos>(make_unique<Msdos::Impl>());
 	Device::Impl::create(devicegraph, msdos);
 	return msdos.get();
     }
@@ -43,7 +43,7 @@ namespace storage
     Msdos*
     Msdos::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<Msdos> msdos = make_shared<Msdos>(make_unique<Msdos::Impl>(node));
+	shared_ptr<Msdos> msdos = make_pooled<Msdos>(make_unique<Msdos::Impl>(node));
 	Device::Impl::load(devicegraph, msdos);
 	return msdos.get();
     }
@@ -33,7 +33,7 @@ namespace storage
     Multipath*
     Multipath::create(Devicegraph* devicegraph, const string& name)
     {
-	shared_ptr<Multipath> multipath = make_shared<Multipath>(make_unique<Multipath::Impl>(name));
+	shared_ptr<Multipath> multipath = make_pooled<Multipath>(make_unique<Multipath::Impl>(name));
 	Device::Impl::create(devicegraph, multipath);
 	return multipath.get();
     }
@@ -42,7 +42,7 @@ namespace storage
     Multipath*
     Multipath::create(Devicegraph* devicegraph, const string& name, const Region& region)
     {
-	shared_ptr<Multipath> multipath = make_shared<Multipath>(make_unique<Multipath::Impl>(name, region));
+	shared_ptr<Multipath> multipath = make_pooled<Multipath>(make_unique<Multipath::Impl>(name, region));
 	Device::Impl::create(devicegraph, multipath);
 	return multipath.get();
     }
@@ -51,7 +51,7 @@ namespace storage
     Multipath*
     Multipath::create(Devicegraph* devicegraph, const string& name, unsigned long long size)
     {
-	shared_ptr<Multipath> multipath = make_shared<Multipath>(make_unique<Multipath::Impl>(name, Region(0, size / 512, 512)));
+	shared_ptr<Multipath> multipath = make_pooled<Multipath>(make_unique<Multipath::Impl>(name, Region(0, size / 512, 512)));
 	Device::Impl::create(devicegraph, multipath);
 	return multipath.get();
     }
@@ -60,7 +60,7 @@ namespace storage
     Multipath*
     Multipath::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<Multipath> multipath = make_shared<Multipath>(make_unique<Multipath::Impl>(node));
+	shared_ptr<Multipath> multipath = make_pooled<Multipath>(make_unique<Multipath::Impl>(node));
 	Device::Impl::load(devicegraph, multipath);
 	return multipath.get();
     }
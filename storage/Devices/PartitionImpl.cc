@@ -959,8 +959,7 @@ namespace storage
     void
     Partition::Impl::do_create()
     {
-	const PartitionTable* partition_table = get_partition_table();
-	const Partitionable* partitionable = partition_table->get_partitionable();
+	const Partitionable* partitionable = get_partitionable();
 
 	vector<unsigned int> tmps = do_create_calc_hack();
 
@@ -971,14 +970,34 @@ namespace storage
 	if (CmdPartedVersion::supports_wipe_signatures())
 	    cmd_args << "--wipesignatures";
 
-	cmd_args << partitionable->get_name() << "unit" << "s" << "mkpart";
+	cmd_args << partitionable->get_name() << "unit" << "s";
+
+	for (const string& arg : mkpart_args(tmps.size()))
+	    cmd_args << arg;
+
+	udev_settle();
+
+	SystemCmd cmd(cmd_args, SystemCmd::DoThrow);
+
+	do_create_post_hack(tmps);
+
+	do_create_finish();
+    }
+
+
+    vector<string>
+    Partition::Impl::mkpart_args(unsigned int num_tmps) const
+    {
+	const PartitionTable* partition_table = get_partition_table();
+
+	vector<string> ret = { "mkpart" };
 
 	if (is_msdos(partition_table))
-	    cmd_args << toString(get_type());
+	    ret.push_back(toString(get_type()));
 
 	if (is_gpt(partition_table))
 	    // pass empty string as partition name
-	    cmd_args << quote_label("");
+	    ret.push_back(quote_label(""));
 
 	if (get_type() != PartitionType::EXTENDED)
 	{
@@ -992,34 +1011,37 @@ namespace storage
 	    switch (get_id())
 	    {
 		case ID_SWAP:
-		    cmd_args << "linux-swap";
+		    ret.push_back("linux-swap");
 		    break;
 
 		case ID_DOS32:
-		    cmd_args << "fat32";
+		    ret.push_back("fat32");
 		    break;
 
 		case ID_NTFS:
 		case ID_WINDOWS_BASIC_DATA:
-		    cmd_args << "ntfs";
+		    ret.push_back("ntfs");
 		    break;
 
 		default:
-		    cmd_args << "ext2";
+		    ret.push_back("ext2");
 		    break;
 	    }
 	}
 
 	unsigned long long factor = parted_sector_adjustment_factor();
 
-	cmd_args << to_string(get_region().get_start() * factor)
-		 << to_string((get_region().get_end() - tmps.size()) * factor + (factor - 1));
+	ret.push_back(to_string(get_region().get_start() * factor));
+	ret.push_back(to_string((get_region().get_end() - num_tmps) * factor + (factor - 1)));
 
-	udev_settle();
+	return ret;
+    }
 
-	SystemCmd cmd(cmd_args, SystemCmd::DoThrow);
 
-	do_create_post_hack(tmps);
+    void
+    Partition::Impl::do_create_finish()
+    {
+	const PartitionTable* partition_table = get_partition_table();
 
 	if (get_type() == PartitionType::PRIMARY || get_type() == PartitionType::LOGICAL)
 	{
@@ -1039,6 +1061,51 @@ namespace storage
     }
 
 
+    bool
+    Partition::Impl::can_create_coalesced() const
+    {
+	const PartitionTable* partition_table = get_partition_table();
+
+	if (!is_gpt(partition_table) && !is_msdos(partition_table))
+	    return false;
+
+	return do_create_calc_hack().empty();
+    }
+
+
+    void
+    Partition::Impl::do_create_coalesced(const vector<const Partition*>& partitions)
+    {
+	const Partitionable* partitionable = partitions.front()->get_partitionable();
+
+	SystemCmd::Args cmd_args = { PARTED_BIN, "--script" };
+
+	if (CmdPartedVersion::supports_wipe_signatures())
+	    cmd_args << "--wipesignatures";
+
+	cmd_args << partitionable->get_name() << "unit" << "s";
+
+	for (const Partition* partition : partitions)
+	{
+	    for (const string& arg : partition->get_impl().mkpart_args(0))
+		cmd_args << arg;
+	}
+
+	udev_settle();
+
+	SystemCmd cmd(cmd_args, SystemCmd::DoThrow);
+    }
+
+
+    void
+    Partition::Impl::do_create_coalesced_finish()
+    {
+	wait_for_devices({ get_non_impl() });
+
+	do_create_finish();
+    }
+
+
     vector<unsigned int>
     Partition::Impl::do_create_calc_hack() const
     {
@@ -1542,6 +1609,29 @@ namespace storage
     }
 
 
+    void
+    Partition::Impl::do_delete_coalesced(const vector<const Partition*>& partitions)
+    {
+	const Partitionable* partitionable = partitions.front()->get_partitionable();
+
+	SystemCmd::Args cmd_args = { PARTED_BIN, "--script", partitionable->get_name() };
+
+	for (const Partition* partition : partitions)
+	{
+	    partition->get_impl().do_delete_efi_boot_mgr();
+
+	    if (partition->get_type() == PartitionType::PRIMARY || partition->get_type() == PartitionType::LOGICAL)
+	    {
+		partition->get_impl().discard_device();
+	    }
+
+	    cmd_args << "rm" << to_string(partition->get_number());
+	}
+
+	SystemCmd cmd(cmd_args, SystemCmd::DoThrow);
+    }
+
+
     void
     Partition::Impl::do_delete_efi_boot_mgr() const
     {
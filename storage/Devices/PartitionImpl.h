@@ -141,6 +141,30 @@ namespace storage
 	virtual void do_create() override;
 	virtual void do_create_post_verify() const override;
 
+	/**
+	 * Whether the partition can be created together with other
+	 * partitions, see do_create_coalesced().
+	 */
+	bool can_create_coalesced() const;
+
+	/**
+	 * Creates the partitions, all on the same partition table, with one
+	 * parted call. Afterwards do_create_coalesced_finish() must be called
+	 * for every partition.
+	 */
+	static void do_create_coalesced(const vector<const Partition*>& partitions);
+
+	/**
+	 * The part of do_create() after the partition table is written for a
+	 * partition created by do_create_coalesced().
+	 */
+	void do_create_coalesced_finish();
+
+	/**
+	 * The part of do_create() after the partition table is written.
+	 */
+	void do_create_finish();
+
 	virtual Text do_set_type_id_text(Tense tense) const;
 	virtual void do_set_type_id() const;
 
@@ -160,6 +184,12 @@ namespace storage
 	virtual Text do_delete_text(Tense tense) const override;
 	virtual void do_delete() const override;
 
+	/**
+	 * Deletes the partitions, all on the same partition table, with one
+	 * parted call.
+	 */
+	static void do_delete_coalesced(const vector<const Partition*>& partitions);
+
 	void do_delete_efi_boot_mgr() const;
 
 	virtual Text do_resize_text(const CommitData& commit_data, const Action::Resize* action) const override;
@@ -183,6 +213,12 @@ namespace storage
 	void do_create_pre_hack(const vector<unsigned int>& tmps);
 	void do_create_post_hack(const vector<unsigned int>& tmps);
 
+	/**
+	 * Returns the parted mkpart command for the partition. The partition
+	 * is made smaller by num_tmps sectors, see do_create_calc_hack().
+	 */
+	vector<string> mkpart_args(unsigned int num_tmps) const;
+
 	void probe_uuid();
 
     };
@@ -33,7 +33,7 @@ namespace storage
     PlainEncryption*
     PlainEncryption::create(Devicegraph* devicegraph, const string& dm_table_name)
     {
-	shared_ptr<PlainEncryption> plain_encryption = make_shared<PlainEncryption>(make_unique<PlainEncryption::Impl>(dm_table_name));
+	shared_ptr<PlainEncryption> plain_encryption = make_pooled<PlainEncryption>(make_unique<PlainEncryption::Impl>(dm_table_name));
 	Device::Impl::create(devicegraph, plain_encryption);
 	return plain_encryption.get();
     }
@@ -42,7 +42,7 @@ namespace storage
     PlainEncryption*
     PlainEncryption::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<PlainEncryption> plain_encryption = make_shared<PlainEncryption>(make_unique<PlainEncryption::Impl>(node));
+	shared_ptr<PlainEncryption> plain_encryption = make_pooled<PlainEncryption>(make_unique<PlainEncryption::Impl>(node));
 	Device::Impl::load(devicegraph, plain_encryption);
 	return plain_encryption.get();
     }
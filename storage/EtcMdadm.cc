@@ -70,8 +70,6 @@ namespace storage
 
 	set_array_line(array_line(entry), entry.uuid);
 
-	mdadm.save();
-
 	return true;
     }
 
@@ -97,12 +95,17 @@ namespace storage
 
 	lines.erase(it);
 
-	mdadm.save();
-
 	return true;
     }
 
 
+    void
+    EtcMdadm::write() const
+    {
+	mdadm.save();
+    }
+
+
     void
     EtcMdadm::set_device_line(const string& line)
     {
@@ -70,6 +70,12 @@ namespace storage
 
 	bool remove_entry(const string& uuid);
 
+	/**
+	 * Write the file. Modifications by update_entry() and
+	 * remove_entry() are only kept in memory until then.
+	 */
+	void write() const;
+
     protected:
 
 	void set_device_line(const string& line);
@@ -33,7 +33,7 @@ namespace storage
     Bcachefs*
     Bcachefs::create(Devicegraph* devicegraph)
     {
-	shared_ptr<Bcachefs> bcachefs = make_shared<Bcachefs>(make_unique<Bcachefs::Impl>());
+	shared_ptr<Bcachefs> bcachefs = make_pooled<Bcachefs>(make_unique<Bcachefs::Impl>());
 	Device::Impl::create(devicegraph, bcachefs);
 	return bcachefs.get();
     }
@@ -42,7 +42,7 @@ namespace storage
     Bcachefs*
     Bcachefs::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<Bcachefs> bcachefs = make_shared<Bcachefs>(make_unique<Bcachefs::Impl>(node));
+	shared_ptr<Bcachefs> bcachefs = make_pooled<Bcachefs>(make_unique<Bcachefs::Impl>(node));
 	Device::Impl::load(devicegraph, bcachefs);
 	return bcachefs.get();
     }
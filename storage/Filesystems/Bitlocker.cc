@@ -33,7 +33,7 @@ namespace storage
     Bitlocker*
     Bitlocker::create(Devicegraph* devicegraph)
     {
-	shared_ptr<Bitlocker> bitlocker = make_shared<Bitlocker>(make_unique<Bitlocker::Impl>());
+	shared_ptr<Bitlocker> bitlocker = make_pooled<Bitlocker>(make_unique<Bitlocker::Impl>());
 	Device::Impl::create(devicegraph, bitlocker);
 	return bitlocker.get();
     }
@@ -42,7 +42,7 @@ namespace storage
     Bitlocker*
     Bitlocker::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<Bitlocker> bitlocker = make_shared<Bitlocker>(make_unique<Bitlocker::Impl>(node));
+	shared_ptr<Bitlocker> bitlocker = make_pooled<Bitlocker>(make_unique<Bitlocker::Impl>(node));
 	Device::Impl::load(devicegraph, bitlocker);
 	return bitlocker.get();
     }
@@ -262,11 +262,16 @@ namespace storage
     vector<const BlkFilesystem*>
     BlkFilesystem::find_by_uuid(const Devicegraph* devicegraph, const string& uuid)
     {
-	auto pred = [&uuid](const BlkFilesystem* blk_filesystem) {
-	    return blk_filesystem->get_uuid() == uuid;
-	};
+	const Devicegraph::Impl& impl = devicegraph->get_impl();
 
-	return devicegraph->get_impl().get_devices_of_type_if<const BlkFilesystem>(pred);
+	auto key_fnc = [](const BlkFilesystem* blk_filesystem) { return blk_filesystem->get_uuid(); };
+
+	vector<const BlkFilesystem*> ret;
+
+	for (Devicegraph::Impl::vertex_descriptor vertex : impl.lookup_vertices<BlkFilesystem>(LookupKey::UUID, uuid, key_fnc))
+	    ret.push_back(dynamic_cast<const BlkFilesystem*>(impl[vertex]));
+
+	return ret;
     }
 
 
@@ -249,8 +249,8 @@ namespace storage
 	Blkid::const_iterator it = blkid.find_by_any_name(blk_device->get_name(), system_info);
 	if (it != blkid.end())
 	{
-	    label = it->second.fs_label;
-	    uuid = it->second.fs_uuid;
+	    set_label(it->second.fs_label);
+	    set_uuid(it->second.fs_uuid);
 	}
     }
 
@@ -265,7 +265,7 @@ namespace storage
 	const Blkid blkid(udevadm, blk_device->get_name());
 	Blkid::const_iterator it = blkid.get_sole_entry();
 	if (it != blkid.end())
-	    uuid = it->second.fs_uuid;
+	    set_uuid(it->second.fs_uuid);
     }
 
 
@@ -582,7 +582,7 @@ namespace storage
 	Devicegraph* devicegraph = get_devicegraph();
 	Devicegraph::Impl::vertex_descriptor vertex = get_vertex();
 
-	return devicegraph->get_impl().filter_devices_of_type<BlkDevice>(devicegraph->get_impl().parents(vertex));
+	return devicegraph->get_impl().filter_devices_of_type<BlkDevice>(devicegraph->get_impl().parents_range(vertex));
     }
 
 
@@ -592,7 +592,7 @@ namespace storage
 	const Devicegraph* devicegraph = get_devicegraph();
 	Devicegraph::Impl::vertex_descriptor vertex = get_vertex();
 
-	return devicegraph->get_impl().filter_devices_of_type<BlkDevice>(devicegraph->get_impl().parents(vertex));
+	return devicegraph->get_impl().filter_devices_of_type<BlkDevice>(devicegraph->get_impl().parents_range(vertex));
     }
 
 
@@ -629,6 +629,16 @@ namespace storage
     }
 
 
+    void
+    BlkFilesystem::Impl::add_to_content_hash(size_t& seed) const
+    {
+	Filesystem::Impl::add_to_content_hash(seed);
+
+	boost::hash_combine(seed, label);
+	boost::hash_combine(seed, uuid);
+    }
+
+
     void
     BlkFilesystem::Impl::log_diff(std::ostream& log, const Device::Impl& rhs_base) const
     {
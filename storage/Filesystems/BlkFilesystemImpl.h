@@ -70,13 +70,13 @@ namespace storage
 	virtual unsigned int max_labelsize() const = 0;
 
 	const string& get_label() const { return label; }
-	void set_label(const string& label) { Impl::label = label; }
+	void set_label(const string& label) { Impl::label = label; content_changed(); }
 
 	virtual bool supports_uuid() const = 0;
 	virtual bool supports_modify_uuid() const { return false; }
 
 	const string& get_uuid() const { return uuid; }
-	void set_uuid(const string& uuid) { Impl::uuid = uuid; }
+	void set_uuid(const string& uuid) { set_lookup_key(Impl::uuid, uuid); }
 
 	virtual bool supports_external_journal() const { return false; }
 
@@ -177,6 +177,8 @@ namespace storage
 
 	virtual void save(xmlNode* node) const override;
 
+	virtual void add_to_content_hash(size_t& seed) const override;
+
 	virtual void probe_uuid();
 
 	static bool detect_is_windows(const string& mount_point);
@@ -57,7 +57,7 @@ namespace storage
     Btrfs*
     Btrfs::create(Devicegraph* devicegraph)
     {
-	shared_ptr<Btrfs> btrfs = make_shared<Btrfs>(make_unique<Btrfs::Impl>());
+	shared_ptr<Btrfs> btrfs = make_pooled<Btrfs>(make_unique<Btrfs::Impl>());
 	Device::Impl::create(devicegraph, btrfs);
 
 	// create BtrfsSubvolume for the top-level subvolume
@@ -73,7 +73,7 @@ namespace storage
     Btrfs*
     Btrfs::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<Btrfs> btrfs = make_shared<Btrfs>(make_unique<Btrfs::Impl>(node));
+	shared_ptr<Btrfs> btrfs = make_pooled<Btrfs>(make_unique<Btrfs::Impl>(node));
 	Device::Impl::load(devicegraph, btrfs);
 	return btrfs.get();
     }
@@ -35,7 +35,7 @@ namespace storage
     BtrfsQgroup*
     BtrfsQgroup::create(Devicegraph* devicegraph, const id_t& id)
     {
-	shared_ptr<BtrfsQgroup> btrfs_qgroup = make_shared<BtrfsQgroup>(make_unique<BtrfsQgroup::Impl>(id));
+	shared_ptr<BtrfsQgroup> btrfs_qgroup = make_pooled<BtrfsQgroup>(make_unique<BtrfsQgroup::Impl>(id));
 	Device::Impl::create(devicegraph, btrfs_qgroup);
 	return btrfs_qgroup.get();
     }
@@ -44,7 +44,7 @@ namespace storage
     BtrfsQgroup*
     BtrfsQgroup::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<BtrfsQgroup> btrfs_qgroup = make_shared<BtrfsQgroup>(make_unique<BtrfsQgroup::Impl>(node));
+	shared_ptr<BtrfsQgroup> btrfs_qgroup = make_pooled<BtrfsQgroup>(make_unique<BtrfsQgroup::Impl>(node));
 	Device::Impl::load(devicegraph, btrfs_qgroup);
 	return btrfs_qgroup.get();
     }
@@ -33,7 +33,7 @@ namespace storage
     BtrfsSubvolume*
     BtrfsSubvolume::create(Devicegraph* devicegraph, const string& path)
     {
-	shared_ptr<BtrfsSubvolume> btrfs_subvolume = make_shared<BtrfsSubvolume>(make_unique<BtrfsSubvolume::Impl>(path));
+	shared_ptr<BtrfsSubvolume> btrfs_subvolume = make_pooled<BtrfsSubvolume>(make_unique<BtrfsSubvolume::Impl>(path));
 	Device::Impl::create(devicegraph, btrfs_subvolume);
 	return btrfs_subvolume.get();
     }
@@ -42,7 +42,7 @@ namespace storage
     BtrfsSubvolume*
     BtrfsSubvolume::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<BtrfsSubvolume> btrfs_subvolume = make_shared<BtrfsSubvolume>(make_unique<BtrfsSubvolume::Impl>(node));
+	shared_ptr<BtrfsSubvolume> btrfs_subvolume = make_pooled<BtrfsSubvolume>(make_unique<BtrfsSubvolume::Impl>(node));
 	Device::Impl::load(devicegraph, btrfs_subvolume);
 	return btrfs_subvolume.get();
     }
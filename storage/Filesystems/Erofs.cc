@@ -33,7 +33,7 @@ namespace storage
     Erofs*
     Erofs::create(Devicegraph* devicegraph)
     {
-	shared_ptr<Erofs> erofs = make_shared<Erofs>(make_unique<Erofs::Impl>());
+	shared_ptr<Erofs> erofs = make_pooled<Erofs>(make_unique<Erofs::Impl>());
 	Device::Impl::create(devicegraph, erofs);
 	return erofs.get();
     }
@@ -42,7 +42,7 @@ namespace storage
     Erofs*
     Erofs::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<Erofs> erofs = make_shared<Erofs>(make_unique<Erofs::Impl>(node));
+	shared_ptr<Erofs> erofs = make_pooled<Erofs>(make_unique<Erofs::Impl>(node));
 	Device::Impl::load(devicegraph, erofs);
 	return erofs.get();
     }
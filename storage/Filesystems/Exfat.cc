@@ -33,7 +33,7 @@ namespace storage
     Exfat*
     Exfat::create(Devicegraph* devicegraph)
     {
-	shared_ptr<Exfat> exfat = make_shared<Exfat>(make_unique<Exfat::Impl>());
+	shared_ptr<Exfat> exfat = make_pooled<Exfat>(make_unique<Exfat::Impl>());
 	Device::Impl::create(devicegraph, exfat);
 	return exfat.get();
     }
@@ -42,7 +42,7 @@ namespace storage
     Exfat*
     Exfat::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<Exfat> exfat = make_shared<Exfat>(make_unique<Exfat::Impl>(node));
+	shared_ptr<Exfat> exfat = make_pooled<Exfat>(make_unique<Exfat::Impl>(node));
 	Device::Impl::load(devicegraph, exfat);
 	return exfat.get();
     }
@@ -34,7 +34,7 @@ namespace storage
     Ext3*
     Ext3::create(Devicegraph* devicegraph)
     {
-	shared_ptr<Ext3> ext3 = make_shared<Ext3>(make_unique<Ext3::Impl>());
+	shared_ptr<Ext3> ext3 = make_pooled<Ext3>(make_unique<Ext3::Impl>());
 	Device::Impl::create(devicegraph, ext3);
 	return ext3.get();
     }
@@ -43,7 +43,7 @@ namespace storage
     Ext3*
     Ext3::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<Ext3> ext3 = make_shared<Ext3>(make_unique<Ext3::Impl>(node));
+	shared_ptr<Ext3> ext3 = make_pooled<Ext3>(make_unique<Ext3::Impl>(node));
 	Device::Impl::load(devicegraph, ext3);
 	return ext3.get();
     }
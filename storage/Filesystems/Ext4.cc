@@ -34,7 +34,7 @@ namespace storage
     Ext4*
     Ext4::create(Devicegraph* devicegraph)
     {
-	shared_ptr<Ext4> ext4 = make_shared<Ext4>(make_unique<Ext4::Impl>());
+	shared_ptr<Ext4> ext4 = make_pooled<Ext4>(make_unique<Ext4::Impl>());
 	Device::Impl::create(devicegraph, ext4);
 	return ext4.get();
     }
@@ -43,7 +43,7 @@ namespace storage
     Ext4*
     Ext4::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<Ext4> ext4 = make_shared<Ext4>(make_unique<Ext4::Impl>(node));
+	shared_ptr<Ext4> ext4 = make_pooled<Ext4>(make_unique<Ext4::Impl>(node));
 	Device::Impl::load(devicegraph, ext4);
 	return ext4.get();
     }
@@ -33,7 +33,7 @@ namespace storage
     Jfs*
     Jfs::create(Devicegraph* devicegraph)
     {
-	shared_ptr<Jfs> jfs = make_shared<Jfs>(make_unique<Jfs::Impl>());
+	shared_ptr<Jfs> jfs = make_pooled<Jfs>(make_unique<Jfs::Impl>());
 	Device::Impl::create(devicegraph, jfs);
 	return jfs.get();
     }
@@ -42,7 +42,7 @@ namespace storage
     Jfs*
     Jfs::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<Jfs> jfs = make_shared<Jfs>(make_unique<Jfs::Impl>(node));
+	shared_ptr<Jfs> jfs = make_pooled<Jfs>(make_unique<Jfs::Impl>(node));
 	Device::Impl::load(devicegraph, jfs);
 	return jfs.get();
     }
@@ -40,7 +40,7 @@ namespace storage
     MountPoint*
     MountPoint::create(Devicegraph* devicegraph, const string& path)
     {
-	shared_ptr<MountPoint> mount_point = make_shared<MountPoint>(make_unique<MountPoint::Impl>(path));
+	shared_ptr<MountPoint> mount_point = make_pooled<MountPoint>(make_unique<MountPoint::Impl>(path));
 	Device::Impl::create(devicegraph, mount_point);
 	return mount_point.get();
     }
@@ -49,7 +49,7 @@ namespace storage
     MountPoint*
     MountPoint::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<MountPoint> mount_point = make_shared<MountPoint>(make_unique<MountPoint::Impl>(node));
+	shared_ptr<MountPoint> mount_point = make_pooled<MountPoint>(make_unique<MountPoint::Impl>(node));
 	Device::Impl::load(devicegraph, mount_point);
 	return mount_point.get();
     }
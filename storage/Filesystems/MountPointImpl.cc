@@ -147,6 +147,8 @@ namespace storage
 #endif
 
 	Impl::path = normalize_path(path);
+
+	content_changed();
     }
 
 
@@ -171,6 +173,22 @@ namespace storage
     }
 
 
+    void
+    MountPoint::Impl::add_to_content_hash(size_t& seed) const
+    {
+	Device::Impl::add_to_content_hash(seed);
+
+	boost::hash_combine(seed, path);
+	boost::hash_combine(seed, static_cast<int>(mount_by));
+	boost::hash_combine(seed, static_cast<int>(mount_type));
+	boost::hash_combine(seed, freq);
+	boost::hash_combine(seed, passno);
+	boost::hash_combine(seed, active);
+	boost::hash_combine(seed, in_etc_fstab);
+	boost::hash_combine(seed, rootprefixed);
+    }
+
+
     void
     MountPoint::Impl::log_diff(std::ostream& log, const Device::Impl& rhs_base) const
     {
@@ -284,6 +302,8 @@ namespace storage
 	    ST_THROW(Exception("illegal mount type"));
 
 	Impl::mount_type = mount_type;
+
+	content_changed();
     }
 
 
@@ -608,8 +628,8 @@ namespace storage
 	for (FstabEntry* entry : mountable->get_impl().find_etc_fstab_entries(etc_fstab, fstab_anchor))
 	{
 	    entry->set_spec(get_mount_by_name());
-	    etc_fstab.log_diff();
-	    etc_fstab.write();
+
+	    commit_data.set_etc_fstab_dirty();
 	}
     }
 
@@ -98,10 +98,10 @@ namespace storage
 	void set_path(const string& path);
 
 	bool is_rootprefixed() const { return rootprefixed; }
-	void set_rootprefixed(bool rootprefixed) { Impl::rootprefixed = rootprefixed; }
+	void set_rootprefixed(bool rootprefixed) { Impl::rootprefixed = rootprefixed; content_changed(); }
 
 	MountByType get_mount_by() const { return mount_by; }
-	void set_mount_by(MountByType mount_by) { Impl::mount_by = mount_by; }
+	void set_mount_by(MountByType mount_by) { Impl::mount_by = mount_by; content_changed(); }
 
 	vector<MountByType> possible_mount_bys() const;
 
@@ -120,16 +120,16 @@ namespace storage
 	bool is_read_only() const;
 
 	int get_freq() const { return freq; }
-	void set_freq(int freq) { Impl::freq = freq; }
+	void set_freq(int freq) { Impl::freq = freq; content_changed(); }
 
 	int get_passno() const { return passno; }
-	void set_passno(int passno) { Impl::passno = passno; }
+	void set_passno(int passno) { Impl::passno = passno; content_changed(); }
 
 	bool is_in_etc_fstab() const { return in_etc_fstab; }
-	void set_in_etc_fstab(bool in_etc_fstab) { Impl::in_etc_fstab = in_etc_fstab; }
+	void set_in_etc_fstab(bool in_etc_fstab) { Impl::in_etc_fstab = in_etc_fstab; content_changed(); }
 
 	bool is_active() const { return active; }
-	void set_active(bool active) { Impl::active = active; }
+	void set_active(bool active) { Impl::active = active; content_changed(); }
 
 	bool has_mountable() const;
 
@@ -199,6 +199,8 @@ namespace storage
 
 	virtual void save(xmlNode* node) const override;
 
+	virtual void add_to_content_hash(size_t& seed) const override;
+
 	virtual void check(const CheckCallbacks* check_callbacks) const override;
 
     private:
@@ -446,8 +446,8 @@ namespace storage
 	entry->set_dump_pass(mount_point->get_freq());
 
 	etc_fstab.add(entry);
-	etc_fstab.log_diff();
-	etc_fstab.write();
+
+	commit_data.set_etc_fstab_dirty();
     }
 
 
@@ -486,8 +486,7 @@ namespace storage
 	    entry->set_fsck_pass(mount_point->get_passno());
 	    entry->set_dump_pass(mount_point->get_freq());
 
-	    etc_fstab.log_diff();
-	    etc_fstab.write();
+	    commit_data.set_etc_fstab_dirty();
 	}
     }
 
@@ -521,8 +520,8 @@ namespace storage
 	for (FstabEntry* entry : find_etc_fstab_entries(etc_fstab, fstab_anchor))
 	{
 	    etc_fstab.remove(entry);
-	    etc_fstab.log_diff();
-	    etc_fstab.write();
+
+	    commit_data.set_etc_fstab_dirty();
 	}
     }
 
@@ -40,7 +40,7 @@ namespace storage
     Nfs*
     Nfs::create(Devicegraph* devicegraph, const string& server, const string& path)
     {
-	shared_ptr<Nfs> nfs = make_shared<Nfs>(make_unique<Nfs::Impl>(server, path));
+	shared_ptr<Nfs> nfs = make_pooled<Nfs>(make_unique<Nfs::Impl>(server, path));
 	Device::Impl::create(devicegraph, nfs);
 	return nfs.get();
     }
@@ -49,7 +49,7 @@ namespace storage
     Nfs*
     Nfs::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<Nfs> nfs = make_shared<Nfs>(make_unique<Nfs::Impl>(node));
+	shared_ptr<Nfs> nfs = make_pooled<Nfs>(make_unique<Nfs::Impl>(node));
 	Device::Impl::load(devicegraph, nfs);
 	return nfs.get();
     }
@@ -33,7 +33,7 @@ namespace storage
     Nilfs2*
     Nilfs2::create(Devicegraph* devicegraph)
     {
-	shared_ptr<Nilfs2> nilfs2 = make_shared<Nilfs2>(make_unique<Nilfs2::Impl>());
+	shared_ptr<Nilfs2> nilfs2 = make_pooled<Nilfs2>(make_unique<Nilfs2::Impl>());
 	Device::Impl::create(devicegraph, nilfs2);
 	return nilfs2.get();
     }
@@ -42,7 +42,7 @@ namespace storage
     Nilfs2*
     Nilfs2::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<Nilfs2> nilfs2 = make_shared<Nilfs2>(make_unique<Nilfs2::Impl>(node));
+	shared_ptr<Nilfs2> nilfs2 = make_pooled<Nilfs2>(make_unique<Nilfs2::Impl>(node));
 	Device::Impl::load(devicegraph, nilfs2);
 	return nilfs2.get();
     }
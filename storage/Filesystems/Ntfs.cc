@@ -34,7 +34,7 @@ namespace storage
     Ntfs*
     Ntfs::create(Devicegraph* devicegraph)
     {
-	shared_ptr<Ntfs> ntfs = make_shared<Ntfs>(make_unique<Ntfs::Impl>());
+	shared_ptr<Ntfs> ntfs = make_pooled<Ntfs>(make_unique<Ntfs::Impl>());
 	Device::Impl::create(devicegraph, ntfs);
 	return ntfs.get();
     }
@@ -43,7 +43,7 @@ namespace storage
     Ntfs*
     Ntfs::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<Ntfs> ntfs = make_shared<Ntfs>(make_unique<Ntfs::Impl>(node));
+	shared_ptr<Ntfs> ntfs = make_pooled<Ntfs>(make_unique<Ntfs::Impl>(node));
 	Device::Impl::load(devicegraph, ntfs);
 	return ntfs.get();
     }
@@ -33,7 +33,7 @@ namespace storage
     Reiserfs*
     Reiserfs::create(Devicegraph* devicegraph)
     {
-	shared_ptr<Reiserfs> reiserfs = make_shared<Reiserfs>(make_unique<Reiserfs::Impl>());
+	shared_ptr<Reiserfs> reiserfs = make_pooled<Reiserfs>(make_unique<Reiserfs::Impl>());
 	Device::Impl::create(devicegraph, reiserfs);
 	return reiserfs.get();
     }
@@ -42,7 +42,7 @@ namespace storage
     Reiserfs*
     Reiserfs::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<Reiserfs> reiserfs = make_shared<Reiserfs>(make_unique<Reiserfs::Impl>(node));
+	shared_ptr<Reiserfs> reiserfs = make_pooled<Reiserfs>(make_unique<Reiserfs::Impl>(node));
 	Device::Impl::load(devicegraph, reiserfs);
 	return reiserfs.get();
     }
@@ -33,7 +33,7 @@ namespace storage
     Squashfs*
     Squashfs::create(Devicegraph* devicegraph)
     {
-	shared_ptr<Squashfs> squashfs = make_shared<Squashfs>(make_unique<Squashfs::Impl>());
+	shared_ptr<Squashfs> squashfs = make_pooled<Squashfs>(make_unique<Squashfs::Impl>());
 	Device::Impl::create(devicegraph, squashfs);
 	return squashfs.get();
     }
@@ -42,7 +42,7 @@ namespace storage
     Squashfs*
     Squashfs::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<Squashfs> squashfs = make_shared<Squashfs>(make_unique<Squashfs::Impl>(node));
+	shared_ptr<Squashfs> squashfs = make_pooled<Squashfs>(make_unique<Squashfs::Impl>(node));
 	Device::Impl::load(devicegraph, squashfs);
 	return squashfs.get();
     }
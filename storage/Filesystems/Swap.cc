@@ -34,7 +34,7 @@ namespace storage
     Swap*
     Swap::create(Devicegraph* devicegraph)
     {
-	shared_ptr<Swap> swap = make_shared<Swap>(make_unique<Swap::Impl>());
+	shared_ptr<Swap> swap = make_pooled<Swap>(make_unique<Swap::Impl>());
 	Device::Impl::create(devicegraph, swap);
 	return swap.get();
     }
@@ -43,7 +43,7 @@ namespace storage
     Swap*
     Swap::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<Swap> swap = make_shared<Swap>(make_unique<Swap::Impl>(node));
+	shared_ptr<Swap> swap = make_pooled<Swap>(make_unique<Swap::Impl>(node));
 	Device::Impl::load(devicegraph, swap);
 	return swap.get();
     }
@@ -33,7 +33,7 @@ namespace storage
     Tmpfs*
     Tmpfs::create(Devicegraph* devicegraph)
     {
-	shared_ptr<Tmpfs> tmpfs = make_shared<Tmpfs>(make_unique<Tmpfs::Impl>());
+	shared_ptr<Tmpfs> tmpfs = make_pooled<Tmpfs>(make_unique<Tmpfs::Impl>());
 	Device::Impl::create(devicegraph, tmpfs);
 	return tmpfs.get();
     }
@@ -42,7 +42,7 @@ namespace storage
     Tmpfs*
     Tmpfs::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<Tmpfs> tmpfs = make_shared<Tmpfs>(make_unique<Tmpfs::Impl>(node));
+	shared_ptr<Tmpfs> tmpfs = make_pooled<Tmpfs>(make_unique<Tmpfs::Impl>(node));
 	Device::Impl::load(devicegraph, tmpfs);
 	return tmpfs.get();
     }
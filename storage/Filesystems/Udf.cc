@@ -33,7 +33,7 @@ namespace storage
     Udf*
     Udf::create(Devicegraph* devicegraph)
     {
-	shared_ptr<Udf> udf = make_shared<Udf>(make_unique<Udf::Impl>());
+	shared_ptr<Udf> udf = make_pooled<Udf>(make_unique<Udf::Impl>());
 	Device::Impl::create(devicegraph, udf);
 	return udf.get();
     }
@@ -42,7 +42,7 @@ namespace storage
     Udf*
     Udf::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<Udf> udf = make_shared<Udf>(make_unique<Udf::Impl>(node));
+	shared_ptr<Udf> udf = make_pooled<Udf>(make_unique<Udf::Impl>(node));
 	Device::Impl::load(devicegraph, udf);
 	return udf.get();
     }
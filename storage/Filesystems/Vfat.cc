@@ -33,7 +33,7 @@ namespace storage
     Vfat*
     Vfat::create(Devicegraph* devicegraph)
     {
-	shared_ptr<Vfat> vfat = make_shared<Vfat>(make_unique<Vfat::Impl>());
+	shared_ptr<Vfat> vfat = make_pooled<Vfat>(make_unique<Vfat::Impl>());
 	Device::Impl::create(devicegraph, vfat);
 	return vfat.get();
     }
@@ -42,7 +42,7 @@ namespace storage
     Vfat*
     Vfat::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<Vfat> vfat = make_shared<Vfat>(make_unique<Vfat::Impl>(node));
+	shared_ptr<Vfat> vfat = make_pooled<Vfat>(make_unique<Vfat::Impl>(node));
 	Device::Impl::load(devicegraph, vfat);
 	return vfat.get();
     }
@@ -34,7 +34,7 @@ namespace storage
     Xfs*
     Xfs::create(Devicegraph* devicegraph)
     {
-	shared_ptr<Xfs> xfs = make_shared<Xfs>(make_unique<Xfs::Impl>());
+	shared_ptr<Xfs> xfs = make_pooled<Xfs>(make_unique<Xfs::Impl>());
 	Device::Impl::create(devicegraph, xfs);
 	return xfs.get();
     }
@@ -43,7 +43,7 @@ namespace storage
     Xfs*
     Xfs::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<Xfs> xfs = make_shared<Xfs>(make_unique<Xfs::Impl>(node));
+	shared_ptr<Xfs> xfs = make_pooled<Xfs>(make_unique<Xfs::Impl>(node));
 	Device::Impl::load(devicegraph, xfs);
 	return xfs.get();
     }
@@ -33,20 +33,27 @@
 namespace storage
 {
     using std::string;
+    using std::vector;
 
 
+    /**
+     * Find the device of Type with name in the devicegraph. Uses the lookup
+     * index of the devicegraph.
+     */
     template<typename Type>
     Type*
     find_by_name(Devicegraph* devicegraph, const string& name)
     {
-	for (Devicegraph::Impl::vertex_descriptor vertex : devicegraph->get_impl().vertices())
-	{
-	    Type* device = dynamic_cast<Type*>(devicegraph->get_impl()[vertex]);
-	    if (device && device->get_impl().get_name() == name)
-		return device;
-	}
-
-	ST_THROW(DeviceNotFoundByName(name));
+	const Devicegraph::Impl& impl = devicegraph->get_impl();
+
+	auto key_fnc = [](const Type* device) { return device->get_impl().get_name(); };
+
+	vector<Devicegraph::Impl::vertex_descriptor> vertices =
+	    impl.lookup_vertices<Type>(LookupKey::NAME, name, key_fnc);
+	if (vertices.empty())
+	    ST_THROW(DeviceNotFoundByName(name));
+
+	return dynamic_cast<Type*>(devicegraph->get_impl()[vertices.front()]);
     }
 
 
@@ -54,29 +61,37 @@ namespace storage
     const Type*
     find_by_name(const Devicegraph* devicegraph, const string& name)
     {
-	for (Devicegraph::Impl::vertex_descriptor vertex : devicegraph->get_impl().vertices())
-	{
-	    const Type* device = dynamic_cast<const Type*>(devicegraph->get_impl()[vertex]);
-	    if (device && device->get_impl().get_name() == name)
-		return device;
-	}
-
-	ST_THROW(DeviceNotFoundByName(name));
+	const Devicegraph::Impl& impl = devicegraph->get_impl();
+
+	auto key_fnc = [](const Type* device) { return device->get_impl().get_name(); };
+
+	vector<Devicegraph::Impl::vertex_descriptor> vertices =
+	    impl.lookup_vertices<Type>(LookupKey::NAME, name, key_fnc);
+	if (vertices.empty())
+	    ST_THROW(DeviceNotFoundByName(name));
+
+	return dynamic_cast<const Type*>(impl[vertices.front()]);
     }
 
 
+    /**
+     * Find the device of Type with uuid in the devicegraph. Uses the lookup
+     * index of the devicegraph.
+     */
     template<typename Type>
     Type*
     find_by_uuid(Devicegraph* devicegraph, const string& uuid)
     {
-	for (Devicegraph::Impl::vertex_descriptor vertex : devicegraph->get_impl().vertices())
-	{
-	    Type* device = dynamic_cast<Type*>(devicegraph->get_impl()[vertex]);
-	    if (device && device->get_impl().get_uuid() == uuid)
-		return device;
-	}
-
-	ST_THROW(DeviceNotFoundByUuid(uuid));
+	const Devicegraph::Impl& impl = devicegraph->get_impl();
+
+	auto key_fnc = [](const Type* device) { return device->get_impl().get_uuid(); };
+
+	vector<Devicegraph::Impl::vertex_descriptor> vertices =
+	    impl.lookup_vertices<Type>(LookupKey::UUID, uuid, key_fnc);
+	if (vertices.empty())
+	    ST_THROW(DeviceNotFoundByUuid(uuid));
+
+	return dynamic_cast<Type*>(devicegraph->get_impl()[vertices.front()]);
     }
 
 
@@ -84,14 +99,16 @@ namespace storage
     const Type*
     find_by_uuid(const Devicegraph* devicegraph, const string& uuid)
     {
-	for (Devicegraph::Impl::vertex_descriptor vertex : devicegraph->get_impl().vertices())
-	{
-	    const Type* device = dynamic_cast<const Type*>(devicegraph->get_impl()[vertex]);
-	    if (device && device->get_impl().get_uuid() == uuid)
-		return device;
-	}
-
-	ST_THROW(DeviceNotFoundByUuid(uuid));
+	const Devicegraph::Impl& impl = devicegraph->get_impl();
+
+	auto key_fnc = [](const Type* device) { return device->get_impl().get_uuid(); };
+
+	vector<Devicegraph::Impl::vertex_descriptor> vertices =
+	    impl.lookup_vertices<Type>(LookupKey::UUID, uuid, key_fnc);
+	if (vertices.empty())
+	    ST_THROW(DeviceNotFoundByUuid(uuid));
+
+	return dynamic_cast<const Type*>(impl[vertices.front()]);
     }
 
 }
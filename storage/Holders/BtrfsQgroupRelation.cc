@@ -30,7 +30,7 @@ namespace storage
     BtrfsQgroupRelation*
     BtrfsQgroupRelation::create(Devicegraph* devicegraph, const Device* source, const Device* target)
     {
-	shared_ptr<BtrfsQgroupRelation> btrfs_qgroup_relation = make_shared<BtrfsQgroupRelation>(make_unique<BtrfsQgroupRelation::Impl>());
+	shared_ptr<BtrfsQgroupRelation> btrfs_qgroup_relation = make_pooled<BtrfsQgroupRelation>(make_unique<BtrfsQgroupRelation::Impl>());
 	Holder::Impl::create(devicegraph, source, target, btrfs_qgroup_relation);
 	return btrfs_qgroup_relation.get();
     }
@@ -39,7 +39,7 @@ namespace storage
     BtrfsQgroupRelation*
     BtrfsQgroupRelation::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<BtrfsQgroupRelation> btrfs_qgroup_relation = make_shared<BtrfsQgroupRelation>(make_unique<BtrfsQgroupRelation::Impl>(node));
+	shared_ptr<BtrfsQgroupRelation> btrfs_qgroup_relation = make_pooled<BtrfsQgroupRelation>(make_unique<BtrfsQgroupRelation::Impl>(node));
 	Holder::Impl::load(devicegraph, node, btrfs_qgroup_relation);
 	return btrfs_qgroup_relation.get();
     }
@@ -30,7 +30,7 @@ namespace storage
     FilesystemUser*
     FilesystemUser::create(Devicegraph* devicegraph, const Device* source, const Device* target)
     {
-	shared_ptr<FilesystemUser> filesystem_user = make_shared<FilesystemUser>(make_unique<FilesystemUser::Impl>());
+	shared_ptr<FilesystemUser> filesystem_user = make_pooled<FilesystemUser>(make_unique<FilesystemUser::Impl>());
 	Holder::Impl::create(devicegraph, source, target, filesystem_user);
 	return filesystem_user.get();
     }
@@ -39,7 +39,7 @@ namespace storage
     FilesystemUser*
     FilesystemUser::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<FilesystemUser> filesystem_user = make_shared<FilesystemUser>(make_unique<FilesystemUser::Impl>(node));
+	shared_ptr<FilesystemUser> filesystem_user = make_pooled<FilesystemUser>(make_unique<FilesystemUser::Impl>(node));
 	Holder::Impl::load(devicegraph, node, filesystem_user);
 	return filesystem_user.get();
     }
@@ -55,6 +55,44 @@ namespace storage
     }
 
 
+    size_t
+    Holder::Impl::get_content_hash() const
+    {
+	if (!content_hash_valid)
+	{
+	    size_t seed = 0;
+
+	    // equal() is only called for holders of the same type
+	    boost::hash_combine(seed, string(get_classname()));
+
+	    boost::hash_combine(seed, userdata);
+
+	    content_hash = seed;
+	    content_hash_valid = true;
+	}
+
+	return content_hash;
+    }
+
+
+    void
+    Holder::Impl::content_changed() const
+    {
+	content_hash_valid = false;
+
+	if (devicegraph)
+	    devicegraph->get_impl().content_changed();
+    }
+
+
+    void
+    Holder::Impl::copy_content_state(const Impl& source)
+    {
+	content_hash = source.content_hash;
+	content_hash_valid = source.content_hash_valid;
+    }
+
+
     Holder*
     Holder::Impl::copy_to_devicegraph(Devicegraph* devicegraph) const
     {
@@ -76,10 +114,11 @@ namespace storage
 	Devicegraph::Impl::vertex_descriptor source = devicegraph->get_impl().find_vertex(source_sid);
 	Devicegraph::Impl::vertex_descriptor target = devicegraph->get_impl().find_vertex(target_sid);
 
-	shared_ptr<Holder> holder = get_non_impl()->clone_v2();
+	shared_ptr<Holder> holder = to_pooled(get_non_impl()->clone_v2());
 
 	Devicegraph::Impl::edge_descriptor edge = devicegraph->get_impl().add_edge_v2(source, target, holder);
 	holder->get_impl().set_devicegraph_and_edge(devicegraph, edge);
+	holder->get_impl().copy_content_state(*this);
 
 	return holder.get();
     }
@@ -169,6 +208,15 @@ namespace storage
     }
 
 
+    void
+    Holder::Impl::set_userdata(const map<string, string>& userdata)
+    {
+	Impl::userdata = userdata;
+
+	content_changed();
+    }
+
+
     void
     Holder::Impl::set_source(const Device* source)
     {
@@ -29,6 +29,7 @@
 #include <type_traits>
 
 #include "storage/Utils/ExceptionImpl.h"
+#include "storage/Utils/ObjectPool.h"
 #include "storage/Holders/Holder.h"
 #include "storage/DevicegraphImpl.h"
 #include "storage/ActiongraphImpl.h"
@@ -51,6 +52,9 @@ namespace storage
 
 	virtual ~Impl() {}
 
+	static void* operator new(size_t size) { return ObjectPool::allocate(size); }
+	static void operator delete(void* ptr, size_t size) noexcept { ObjectPool::deallocate(ptr, size); }
+
 	bool operator==(const Impl& rhs) const;
 	bool operator!=(const Impl& rhs) const { return !(*this == rhs); }
 
@@ -98,7 +102,7 @@ namespace storage
 	sid_t get_target_sid() const;
 
 	const map<string, string>& get_userdata() const { return userdata; }
-	void set_userdata(const map<string, string>& userdata) { Impl::userdata = userdata; }
+	void set_userdata(const map<string, string>& userdata);
 
 	/**
 	 * Add create actions for the Holder.
@@ -127,6 +131,24 @@ namespace storage
 	virtual void log_diff(std::ostream& log, const Impl& rhs) const = 0;
 	virtual void print(std::ostream& out) const = 0;
 
+	/**
+	 * Hash over the content of the holder compared by equal(). The sids
+	 * of source and target are not included. See
+	 * Device::Impl::get_content_hash().
+	 */
+	size_t get_content_hash() const;
+
+	/**
+	 * Marks the content hash of the holder and of its devicegraph as
+	 * outdated. Called by set_userdata().
+	 */
+	void content_changed() const;
+
+	/**
+	 * See Device::Impl::copy_content_state().
+	 */
+	void copy_content_state(const Impl& source);
+
 	virtual Text do_create_text(Tense tense) const;
 	virtual void do_create();
 	virtual uf_t do_create_used_features() const { return 0; }
@@ -164,6 +186,9 @@ namespace storage
 
 	map<string, string> userdata;
 
+	mutable size_t content_hash = 0;
+	mutable bool content_hash_valid = false;
+
     };
 
 
@@ -30,7 +30,7 @@ namespace storage
     MdSubdevice*
     MdSubdevice::create(Devicegraph* devicegraph, const Device* source, const Device* target)
     {
-	shared_ptr<MdSubdevice> md_subdevice = make_shared<MdSubdevice>(make_unique<MdSubdevice::Impl>());
+	shared_ptr<MdSubdevice> md_subdevice = make_pooled<MdSubdevice>(make_unique<MdSubdevice::Impl>());
 	Holder::Impl::create(devicegraph, source, target, md_subdevice);
 	return md_subdevice.get();
     }
@@ -39,7 +39,7 @@ namespace storage
     MdSubdevice*
     MdSubdevice::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<MdSubdevice> md_subdevice = make_shared<MdSubdevice>(make_unique<MdSubdevice::Impl>(node));
+	shared_ptr<MdSubdevice> md_subdevice = make_pooled<MdSubdevice>(make_unique<MdSubdevice::Impl>(node));
 	Holder::Impl::load(devicegraph, node, md_subdevice);
 	return md_subdevice.get();
     }
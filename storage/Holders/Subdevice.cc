@@ -31,7 +31,7 @@ namespace storage
     Subdevice*
     Subdevice::create(Devicegraph* devicegraph, const Device* source, const Device* target)
     {
-	shared_ptr<Subdevice> subdevice = make_shared<Subdevice>(make_unique<Subdevice::Impl>());
+	shared_ptr<Subdevice> subdevice = make_pooled<Subdevice>(make_unique<Subdevice::Impl>());
 	Holder::Impl::create(devicegraph, source, target, subdevice);
 	return subdevice.get();
     }
@@ -40,7 +40,7 @@ namespace storage
     Subdevice*
     Subdevice::load(Devicegraph* devicegraph, const xmlNode* node)
     {
-	shared_ptr<Subdevice> subdevice = make_shared<Subdevice>(make_unique<Subdevice::Impl>(node));
+	shared_ptr<Subdevice> subdevice = make_pooled<Subdevice>(make_unique<Subdevice::Impl>(node));
 	Holder::Impl::load(devicegraph, node, subdevice);
 	return subdevice.get();
     }
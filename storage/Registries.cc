@@ -143,6 +143,63 @@ namespace storage
     };
 
 
+    const map<string, string> device_base_registry = {
+	{ "Bcache", "Partitionable" },
+	{ "BcacheCset", "Device" },
+	{ "Bcachefs", "BlkFilesystem" },
+	{ "Bitlocker", "BlkFilesystem" },
+	{ "BitlockerV2", "Encryption" },
+	{ "BlkDevice", "Device" },
+	{ "BlkFilesystem", "Filesystem" },
+	{ "Btrfs", "BlkFilesystem" },
+	{ "BtrfsQgroup", "Device" },
+	{ "BtrfsSubvolume", "Mountable" },
+	{ "Dasd", "Partitionable" },
+	{ "DasdPt", "PartitionTable" },
+	{ "Disk", "Partitionable" },
+	{ "DmRaid", "Partitionable" },
+	{ "Encryption", "BlkDevice" },
+	{ "Erofs", "BlkFilesystem" },
+	{ "Exfat", "BlkFilesystem" },
+	{ "Ext", "BlkFilesystem" },
+	{ "Ext2", "Ext" },
+	{ "Ext3", "Ext" },
+	{ "Ext4", "Ext" },
+	{ "F2fs", "BlkFilesystem" },
+	{ "Filesystem", "Mountable" },
+	{ "Gpt", "PartitionTable" },
+	{ "ImplicitPt", "PartitionTable" },
+	{ "Iso9660", "BlkFilesystem" },
+	{ "Jfs", "BlkFilesystem" },
+	{ "Luks", "Encryption" },
+	{ "LvmLv", "BlkDevice" },
+	{ "LvmPv", "Device" },
+	{ "LvmVg", "Device" },
+	{ "Md", "Partitionable" },
+	{ "MdContainer", "Md" },
+	{ "MdMember", "Md" },
+	{ "Mountable", "Device" },
+	{ "MountPoint", "Device" },
+	{ "Msdos", "PartitionTable" },
+	{ "Multipath", "Partitionable" },
+	{ "Nfs", "Filesystem" },
+	{ "Nilfs2", "BlkFilesystem" },
+	{ "Ntfs", "BlkFilesystem" },
+	{ "Partition", "BlkDevice" },
+	{ "Partitionable", "BlkDevice" },
+	{ "PartitionTable", "Device" },
+	{ "PlainEncryption", "Encryption" },
+	{ "Reiserfs", "BlkFilesystem" },
+	{ "Squashfs", "BlkFilesystem" },
+	{ "StrayBlkDevice", "BlkDevice" },
+	{ "Swap", "BlkFilesystem" },
+	{ "Tmpfs", "Filesystem" },
+	{ "Udf", "BlkFilesystem" },
+	{ "Vfat", "BlkFilesystem" },
+	{ "Xfs", "BlkFilesystem" }
+    };
+
+
     const map<FsType, blk_filesystem_create_fnc> blk_filesystem_create_registry = {
 	{ FsType::BCACHEFS, &Bcachefs::create },
 	{ FsType::BITLOCKER, &Bitlocker::create },
@@ -54,6 +54,13 @@ namespace storage
     extern const map<string, holder_load_fnc> holder_load_registry;
 
 
+    /**
+     * Map with name of all device types, abstract and non-abstract, except Device
+     * itself and the name of the corresponding direct base type.
+     */
+    extern const map<string, string> device_base_registry;
+
+
     typedef std::function<BlkFilesystem* (Devicegraph* devicegraph)> blk_filesystem_create_fnc;
 
     /**
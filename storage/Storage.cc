@@ -23,6 +23,7 @@
 
 #include "storage/StorageImpl.h"
 #include "storage/SystemInfo/SystemInfo.h"
+#include "storage/Utils/Statistics.h"
 
 
 namespace storage
@@ -263,6 +264,41 @@ namespace storage
     }
 
 
+    void
+    Storage::set_devicegraph_statistics_enabled(bool enabled)
+    {
+	Statistics::set_enabled(enabled);
+    }
+
+
+    DevicegraphStatistics
+    Storage::get_devicegraph_statistics() const
+    {
+	return Statistics::get();
+    }
+
+
+    void
+    Storage::reset_devicegraph_statistics()
+    {
+	Statistics::reset();
+    }
+
+
+    shared_ptr<const Devicegraph>
+    Storage::get_probed_snapshot() const
+    {
+	return get_impl().get_probed_snapshot();
+    }
+
+
+    shared_ptr<const Devicegraph>
+    Storage::get_system_snapshot() const
+    {
+	return get_impl().get_system_snapshot();
+    }
+
+
     vector<string>
     Storage::get_devicegraph_names() const
     {
@@ -340,6 +376,34 @@ namespace storage
     }
 
 
+    unsigned int
+    Storage::get_max_parallel_actions() const
+    {
+	return get_impl().get_max_parallel_actions();
+    }
+
+
+    void
+    Storage::set_max_parallel_actions(unsigned int max_parallel_actions)
+    {
+	get_impl().set_max_parallel_actions(max_parallel_actions);
+    }
+
+
+    bool
+    Storage::get_coalesce_partition_actions() const
+    {
+	return get_impl().get_coalesce_partition_actions();
+    }
+
+
+    void
+    Storage::set_coalesce_partition_actions(bool coalesce_partition_actions)
+    {
+	get_impl().set_coalesce_partition_actions(coalesce_partition_actions);
+    }
+
+
     const string&
     Storage::get_rootprefix() const
     {
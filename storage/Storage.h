@@ -49,7 +49,14 @@ namespace storage
      *
      * \section Thread-Safety Thread Safety
      *
-     * There is no guarantee about the thread safety of libstorage.
+     * There is no guarantee about the thread safety of libstorage with
+     * the following exception: const functions of devicegraphs and their
+     * devices and holders may be called concurrently from several threads,
+     * e.g. find_by_name(), get_descendants() or get_all(), as long as no
+     * thread modifies the devicegraph at the same time. Excluded are
+     * functions querying the system, e.g. detect_resize_info(), and
+     * devicegraphs loaded lazily until all devices are created, e.g. by a
+     * call of check().
      *
      * \section Exceptions-and-Side-Effects Exceptions and Side Effects
      *
@@ -391,6 +398,23 @@ namespace storage
     };
 
 
+    /**
+     * Counters and times of devicegraph queries, see
+     * Storage::get_devicegraph_statistics(). Times are in seconds.
+     */
+    struct DevicegraphStatistics
+    {
+	unsigned long long find_vertex = 0;
+	unsigned long long find_edges = 0;
+	unsigned long long traversals = 0;
+	unsigned long long dynamic_casts = 0;
+	unsigned long long copies = 0;
+
+	double traversal_time = 0.0;
+	double copy_time = 0.0;
+    };
+
+
     class CheckCallbacks
     {
     public:
@@ -554,6 +578,28 @@ namespace storage
 	 */
 	const Devicegraph* get_system() const;
 
+	/**
+	 * Return a read-only snapshot of the probed devicegraph. The snapshot
+	 * is a copy made on first request after probing. Probing again
+	 * drops it but does not change snapshots held by the caller. Can be
+	 * called from any thread, see the thread-safety section. If a copy
+	 * must be made while probing or committing runs the call waits for
+	 * it to finish, so it must not be called from the callbacks of
+	 * probing or committing.
+	 *
+	 * The snapshot keeps a pointer to the storage object and thus must
+	 * not outlive it.
+	 */
+	ST_NO_SWIG std::shared_ptr<const Devicegraph> get_probed_snapshot() const;
+
+	/**
+	 * Return a read-only snapshot of the system devicegraph. The snapshot
+	 * is a copy made on first request after probing or committing.
+	 *
+	 * @see get_probed_snapshot()
+	 */
+	ST_NO_SWIG std::shared_ptr<const Devicegraph> get_system_snapshot() const;
+
 	/**
 	 * Checks all devicegraphs.
 	 *
@@ -572,6 +618,30 @@ namespace storage
 	 */
 	void check(const CheckCallbacks* check_callbacks = nullptr) const;
 
+	/**
+	 * Enables or disables counting devicegraph queries: lookups of
+	 * devices by sid and of holders by sids, traversals, e.g. for
+	 * descendants, dynamic casts when filtering devices or holders by
+	 * type, and copies. Disabled by default.
+	 *
+	 * The statistics are collected for all devicegraphs of the process,
+	 * not only the devicegraphs of this storage object.
+	 */
+	void set_devicegraph_statistics_enabled(bool enabled);
+
+	/**
+	 * Returns the devicegraph statistics collected since enabling or
+	 * the last reset.
+	 *
+	 * @see set_devicegraph_statistics_enabled()
+	 */
+	DevicegraphStatistics get_devicegraph_statistics() const;
+
+	/**
+	 * Resets the devicegraph statistics.
+	 */
+	void reset_devicegraph_statistics();
+
 	/**
 	 * Query the default mount-by method.
 	 */
@@ -582,6 +652,47 @@ namespace storage
 	 */
 	void set_default_mount_by(MountByType default_mount_by);
 
+	/**
+	 * Query the maximal number of actions run in parallel by commit().
+	 */
+	unsigned int get_max_parallel_actions() const;
+
+	/**
+	 * Set the maximal number of actions run in parallel by commit(). The
+	 * default is one.
+	 *
+	 * With more than one, create, delete and resize actions on disjoint
+	 * device trees, e.g. creating partitions and filesystems on different
+	 * disks, are run concurrently. All other actions, e.g. on mount
+	 * points, on /etc/fstab, /etc/crypttab and /etc/mdadm.conf and on the
+	 * LVM devices file, are run alone. The callbacks are still called one
+	 * at a time from the calling thread but the begin_action() and
+	 * end_action() calls of actions run in parallel can interleave. The
+	 * logger is also only called from one thread at a time.
+	 *
+	 * @throw Exception
+	 */
+	void set_max_parallel_actions(unsigned int max_parallel_actions);
+
+	/**
+	 * Query whether commit() coalesces partition actions.
+	 */
+	bool get_coalesce_partition_actions() const;
+
+	/**
+	 * Set whether commit() coalesces partition actions. The default is
+	 * false.
+	 *
+	 * If enabled, consecutive create resp. delete actions of partitions
+	 * on the same GPT or MS-DOS partition table are done with a single
+	 * parted call. So the kernel re-reads the partition table only once.
+	 * The actions are still reported one by one. Only the first action
+	 * runs parted, the other actions wait for their partition and finish
+	 * it. Not done if actions run in parallel, see
+	 * set_max_parallel_actions().
+	 */
+	void set_coalesce_partition_actions(bool coalesce_partition_actions);
+
 	const std::string& get_rootprefix() const;
 	void set_rootprefix(const std::string& rootprefix) ST_DEPRECATED;
 
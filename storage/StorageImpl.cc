@@ -187,6 +187,8 @@ namespace storage
 
 	y2mil("rootprefix: " << get_rootprefix());
 
+	std::unique_lock<std::shared_mutex> modify_lock(modify_mutex);
+
 	CallbacksGuard callbacks_guard(probe_callbacks);
 
 	if (exist_devicegraph("probed"))
@@ -244,6 +246,8 @@ namespace storage
 	copy_devicegraph("system", "staging");
 	copy_devicegraph("system", "probed");
 
+	drop_snapshots();
+
 	setup_taboos(system_info);
     }
 
@@ -342,6 +346,61 @@ namespace storage
     }
 
 
+    shared_ptr<const Devicegraph>
+    Storage::Impl::get_probed_snapshot() const
+    {
+	return get_snapshot("probed", probed_snapshot);
+    }
+
+
+    shared_ptr<const Devicegraph>
+    Storage::Impl::get_system_snapshot() const
+    {
+	return get_snapshot("system", system_snapshot);
+    }
+
+
+    shared_ptr<const Devicegraph>
+    Storage::Impl::get_snapshot(const string& name, shared_ptr<const Devicegraph>& snapshot) const
+    {
+	{
+	    std::lock_guard<std::mutex> lock(snapshot_mutex);
+
+	    if (snapshot)
+		return snapshot;
+	}
+
+	// The copy is made while probe() and commit() cannot modify the
+	// devicegraphs. The snapshot is stored before the lock is released
+	// so that it cannot be stored after it was dropped.
+
+	std::shared_lock<std::shared_mutex> modify_lock(modify_mutex);
+
+	shared_ptr<Devicegraph> tmp = make_shared<Devicegraph>(&storage);
+	get_devicegraph(name)->get_impl().copy(*tmp);
+
+	std::lock_guard<std::mutex> lock(snapshot_mutex);
+
+	if (!snapshot)
+	    snapshot = std::move(tmp);
+
+	return snapshot;
+    }
+
+
+    void
+    Storage::Impl::drop_snapshots()
+    {
+	// Snapshots still held by readers stay alive until the last reader
+	// drops them.
+
+	std::lock_guard<std::mutex> lock(snapshot_mutex);
+
+	probed_snapshot.reset();
+	system_snapshot.reset();
+    }
+
+
     vector<string>
     Storage::Impl::get_devicegraph_names() const
     {
@@ -482,6 +541,16 @@ namespace storage
     }
 
 
+    void
+    Storage::Impl::set_max_parallel_actions(unsigned int max_parallel_actions)
+    {
+	if (max_parallel_actions == 0)
+	    ST_THROW(Exception("invalid number of parallel actions 0"));
+
+	Impl::max_parallel_actions = max_parallel_actions;
+    }
+
+
     string
     Storage::Impl::prepend_rootprefix(const string& mount_point) const
     {
@@ -508,9 +577,13 @@ namespace storage
     {
 	ST_CHECK_PTR(actiongraph.get());
 
+	std::unique_lock<std::shared_mutex> modify_lock(modify_mutex);
+
 	actiongraph->get_impl().commit(commit_options, commit_callbacks);
 
 	// TODO somehow update probed
+
+	drop_snapshots();
     }
 
 
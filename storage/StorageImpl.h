@@ -26,6 +26,8 @@
 
 
 #include <set>
+#include <mutex>
+#include <shared_mutex>
 
 #include "storage/Devices/Device.h"
 #include "storage/Utils/FileUtils.h"
@@ -124,11 +126,20 @@ namespace storage
 	Devicegraph* get_system();
 	const Devicegraph* get_system() const;
 
+	std::shared_ptr<const Devicegraph> get_probed_snapshot() const;
+	std::shared_ptr<const Devicegraph> get_system_snapshot() const;
+
 	void check(const CheckCallbacks* check_callbacks) const;
 
 	MountByType get_default_mount_by() const { return default_mount_by; }
 	void set_default_mount_by(MountByType default_mount_by) { Impl::default_mount_by = default_mount_by; }
 
+	unsigned int get_max_parallel_actions() const { return max_parallel_actions; }
+	void set_max_parallel_actions(unsigned int max_parallel_actions);
+
+	bool get_coalesce_partition_actions() const { return coalesce_partition_actions; }
+	void set_coalesce_partition_actions(bool coalesce_partition_actions) { Impl::coalesce_partition_actions = coalesce_partition_actions; }
+
 	const string& get_rootprefix() const { return rootprefix; }
 	void set_rootprefix(const string& rootprefix) { Impl::rootprefix = rootprefix; }
 
@@ -194,6 +205,19 @@ namespace storage
 
 	void setup_taboos(SystemInfo& system_info);
 
+	/**
+	 * Returns the snapshot of the devicegraph name, creating it if
+	 * needed, see Storage::get_probed_snapshot().
+	 */
+	std::shared_ptr<const Devicegraph> get_snapshot(const string& name,
+							std::shared_ptr<const Devicegraph>& snapshot) const;
+
+	/**
+	 * Drops the snapshots after the probed or system devicegraph
+	 * changed. They are created again on next use.
+	 */
+	void drop_snapshots();
+
 	Storage& storage;
 
 	const Environment environment;
@@ -205,11 +229,29 @@ namespace storage
 	using devicegraphs_t = map<string, Devicegraph>;
 	devicegraphs_t devicegraphs;
 
+	/**
+	 * Held exclusively by probe() and commit() while they modify the
+	 * devicegraphs and shared while creating a snapshot.
+	 */
+	mutable std::shared_mutex modify_mutex;
+
+	/**
+	 * Protects the snapshots since readers may run in other threads.
+	 */
+	mutable std::mutex snapshot_mutex;
+
+	mutable std::shared_ptr<const Devicegraph> probed_snapshot;
+	mutable std::shared_ptr<const Devicegraph> system_snapshot;
+
 	using pools_t = map<string, Pool>;
 	pools_t pools;
 
 	MountByType default_mount_by;
 
+	unsigned int max_parallel_actions = 1;
+
+	bool coalesce_partition_actions = false;
+
 	string rootprefix;
 
 	std::unique_ptr<const Actiongraph> actiongraph;
@@ -21,6 +21,8 @@
  */
 
 
+#include <mutex>
+
 #include "storage/SystemInfo/Arch.h"
 #include "storage/Utils/AsciiFile.h"
 #include "storage/Utils/LoggerImpl.h"
@@ -175,9 +177,15 @@ namespace storage
     {
 	// TODO move efibootmgr to Arch class - but breaks ABI
 
+	// Partitions can be deleted in parallel, see
+	// Actiongraph::Impl::commit_parallel().
+
+	static std::mutex mutex;
 	static bool did_check = false;
 	static bool efibootmgr;
 
+	std::lock_guard<std::mutex> lock(mutex);
+
 	if (!did_check)
 	{
 	    // Check that efivars directory is writeable and nonempty (bsc #1185610).
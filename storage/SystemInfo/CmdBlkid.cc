@@ -468,6 +468,8 @@ namespace storage
     void
     CmdBlkidVersion::query_version()
     {
+	std::lock_guard<std::mutex> lock(version_mutex);
+
 	if (did_set_version)
 	    return;
 
@@ -513,6 +515,8 @@ namespace storage
     }
 
 
+    std::mutex CmdBlkidVersion::version_mutex;
+
     bool CmdBlkidVersion::did_set_version = false;
 
     int CmdBlkidVersion::major = 0;
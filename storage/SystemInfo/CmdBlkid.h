@@ -29,6 +29,7 @@
 #include <map>
 #include <vector>
 #include <optional>
+#include <mutex>
 
 #include "storage/Utils/Udev.h"
 #include "storage/Filesystems/Filesystem.h"
@@ -137,6 +138,8 @@ namespace storage
 
     private:
 
+	static std::mutex version_mutex;
+
 	static bool did_set_version;
 
 	static int major;
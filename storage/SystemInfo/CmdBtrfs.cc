@@ -673,6 +673,8 @@ namespace storage
     void
     CmdBtrfsVersion::query_version()
     {
+	std::lock_guard<std::mutex> lock(version_mutex);
+
 	if (did_set_version)
 	    return;
 
@@ -724,6 +726,8 @@ namespace storage
     }
 
 
+    std::mutex CmdBtrfsVersion::version_mutex;
+
     bool CmdBtrfsVersion::did_set_version = false;
 
     int CmdBtrfsVersion::major = 0;
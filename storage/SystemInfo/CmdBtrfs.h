@@ -28,6 +28,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <mutex>
 
 #include "storage/Filesystems/BtrfsSubvolumeImpl.h"
 #include "storage/Filesystems/Btrfs.h"
@@ -296,6 +297,8 @@ namespace storage
 
     private:
 
+	static std::mutex version_mutex;
+
 	static bool did_set_version;
 
 	static int major;
@@ -135,6 +135,8 @@ namespace storage
     void
     CmdLsscsiVersion::query_version()
     {
+	std::lock_guard<std::mutex> lock(version_mutex);
+
 	if (did_set_version)
 	    return;
 
@@ -174,6 +176,8 @@ namespace storage
     }
 
 
+    std::mutex CmdLsscsiVersion::version_mutex;
+
     bool CmdLsscsiVersion::did_set_version = false;
 
     int CmdLsscsiVersion::major = 0;
@@ -28,6 +28,7 @@
 #include <string>
 #include <map>
 #include <vector>
+#include <mutex>
 
 #include "storage/Devices/Disk.h"
 
@@ -77,6 +78,8 @@ namespace storage
 
     private:
 
+	static std::mutex version_mutex;
+
 	static bool did_set_version;
 
 	static int major;
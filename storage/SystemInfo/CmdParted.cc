@@ -682,6 +682,8 @@ namespace storage
     void
     CmdPartedVersion::query_version()
     {
+	std::lock_guard<std::mutex> lock(version_mutex);
+
 	if (did_set_version)
 	    return;
 
@@ -790,6 +792,8 @@ namespace storage
     }
 
 
+    std::mutex CmdPartedVersion::version_mutex;
+
     bool CmdPartedVersion::did_set_version = false;
 
     int CmdPartedVersion::major = 0;
@@ -25,6 +25,8 @@
 #define STORAGE_CMD_PARTED_H
 
 
+#include <mutex>
+
 #include "storage/Utils/Region.h"
 #include "storage/Utils/JsonFile.h"
 #include "storage/Devices/PartitionTable.h"
@@ -239,6 +241,12 @@ namespace storage
 
     private:
 
+	/**
+	 * Protects the version variables since query_version() can be
+	 * called from several threads, e.g. during a parallel commit.
+	 */
+	static std::mutex version_mutex;
+
 	static bool did_set_version;
 
 	static int major;
@@ -42,16 +42,12 @@ namespace storage
     const CmdUdevadmInfo&
     SystemInfo::Impl::getCmdUdevadmInfo(const string& file)
     {
-	for (const auto& tmp : cmd_udevadm_infos.get_data())
-	{
-	    // does not have an object iff the constructor threw
-	    if (!tmp.second.has_object())
-		continue;
-
-	    const CmdUdevadmInfo& cmd_udevadm_info = tmp.second.get_object();
-	    if (cmd_udevadm_info.is_alias_of(file))
-		return cmd_udevadm_info;
-	}
+	const CmdUdevadmInfo* cmd_udevadm_info = cmd_udevadm_infos.find_if([&file](const CmdUdevadmInfo& tmp) {
+	    return tmp.is_alias_of(file);
+	});
+
+	if (cmd_udevadm_info)
+	    return *cmd_udevadm_info;
 
 	return cmd_udevadm_infos.get2(udevadm, file);
     }
@@ -25,6 +25,8 @@
 #define STORAGE_SYSTEM_INFO_IMPL_H
 
 
+#include <mutex>
+
 #include "storage/EtcFstab.h"
 #include "storage/EtcCrypttab.h"
 #include "storage/EtcMdadm.h"
@@ -150,7 +152,10 @@ namespace storage
 
 	/* LazyObject, LazyObjects and LazyObjectsWithKey cache the object and a potential
 	   exception during object construction. The object is constructed during the
-	   first call of get(), thus "lazy". HelperBase does the common part. */
+	   first call of get(), thus "lazy". HelperBase does the common part.
+
+	   LazyObject, LazyObjects and LazyObjectsWithKey can be used from several
+	   threads. Constructing an object holds the lock of its cache. */
 
 	template <class Object, typename... Args>
 	class HelperBase
@@ -214,8 +219,27 @@ namespace storage
 
 
 	template <class Object>
-	class LazyObject : public HelperBase<Object>, private boost::noncopyable
+	class LazyObject : private boost::noncopyable
 	{
+	public:
+
+	    const Object& get()
+	    {
+		std::lock_guard<std::mutex> lock(mutex);
+		return helper.get();
+	    }
+
+	    const Object& get2(Udevadm& udevadm)
+	    {
+		std::lock_guard<std::mutex> lock(mutex);
+		return helper.get2(udevadm);
+	    }
+
+	private:
+
+	    HelperBase<Object> helper;
+	    std::mutex mutex;
+
 	};
 
 
@@ -228,6 +252,8 @@ namespace storage
 
 	    const Object& get(const Arg& arg)
 	    {
+		std::lock_guard<std::mutex> lock(mutex);
+
 		typename map<Arg, Helper>::iterator pos = data.lower_bound(arg);
 		if (pos == data.end() || typename map<Arg, Helper>::key_compare()(arg, pos->first))
 		    pos = data.insert(pos, typename map<Arg, Helper>::value_type(arg, Helper()));
@@ -236,17 +262,36 @@ namespace storage
 
 	    const Object& get2(Udevadm& udevadm, const Arg& arg)
 	    {
+		std::lock_guard<std::mutex> lock(mutex);
+
 		typename map<Arg, Helper>::iterator pos = data.lower_bound(arg);
 		if (pos == data.end() || typename map<Arg, Helper>::key_compare()(arg, pos->first))
 		    pos = data.insert(pos, typename map<Arg, Helper>::value_type(arg, Helper()));
 		return pos->second.get2(udevadm, arg);
 	    }
 
-	    const map<Arg, Helper>& get_data() const { return data; }
+	    /**
+	     * Returns the first constructed object fulfilling pred or nullptr.
+	     */
+	    template <typename Pred>
+	    const Object* find_if(Pred pred)
+	    {
+		std::lock_guard<std::mutex> lock(mutex);
+
+		for (const typename map<Arg, Helper>::value_type& value : data)
+		{
+		    // does not have an object iff the constructor threw
+		    if (value.second.has_object() && pred(value.second.get_object()))
+			return &value.second.get_object();
+		}
+
+		return nullptr;
+	    }
 
 	private:
 
 	    map<Arg, Helper> data;
+	    std::mutex mutex;
 
 	};
 
@@ -262,12 +307,16 @@ namespace storage
 
 	    bool includes(const Key& key) const
 	    {
+		std::lock_guard<std::mutex> lock(mutex);
+
 		typename map<Key, Helper>::const_iterator pos = data.lower_bound(key);
 		return pos != data.end() && !typename map<Key, Helper>::key_compare()(key, pos->first);
 	    }
 
 	    const Object& get(const Key& key, Args... args)
 	    {
+		std::lock_guard<std::mutex> lock(mutex);
+
 		typename map<Key, Helper>::iterator pos = data.lower_bound(key);
 		if (pos == data.end() || typename map<Key, Helper>::key_compare()(key, pos->first))
 		    pos = data.insert(pos, typename map<Key, Helper>::value_type(key, Helper()));
@@ -277,6 +326,7 @@ namespace storage
 	private:
 
 	    map<Key, Helper> data;
+	    mutable std::mutex mutex;
 
 	};
 
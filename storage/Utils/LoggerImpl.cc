@@ -21,6 +21,8 @@
  */
 
 
+#include <mutex>
+
 #include "storage/Utils/LoggerImpl.h"
 
 
@@ -32,13 +34,26 @@ namespace storage
     static const string& component = "libstorage";
 
 
+    /**
+     * Serializes the calls of the logger since actions committed in
+     * parallel log from several threads, see
+     * Actiongraph::Impl::commit_parallel(). So the logger does not need to
+     * be thread-safe.
+     */
+    static mutex logger_mutex;
+
+
     bool
     query_log_level(LogLevel log_level)
     {
 	Logger* logger = get_logger();
 
 	if (logger)
+	{
+	    lock_guard<mutex> lock(logger_mutex);
+
 	    return logger->test(log_level, component);
+	}
 
 	return false;
     }
@@ -78,6 +93,8 @@ namespace storage
 
 	const string content = stream->str();
 
+	lock_guard<mutex> lock(logger_mutex);
+
 	string::size_type pos1 = 0;
 	while (true)
 	{
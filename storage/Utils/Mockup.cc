@@ -36,6 +36,8 @@ namespace storage
     void
     Mockup::load(const string& filename)
     {
+	std::lock_guard<std::mutex> lock(mutex);
+
 	XmlFile xml(filename);
 
 	const xmlNode* root_node = xml.getRootElement();
@@ -130,6 +132,8 @@ namespace storage
     void
     Mockup::save(const string& filename)
     {
+	std::lock_guard<std::mutex> lock(mutex);
+
 	XmlFile xml;
 
 	xmlNode* mockup_node = xmlNewNode("Mockup");
@@ -173,13 +177,17 @@ namespace storage
     bool
     Mockup::has_command(const string& name)
     {
+	std::lock_guard<std::mutex> lock(mutex);
+
 	return commands.find(name) != commands.end();
     }
 
 
-    const Mockup::Command&
+    Mockup::Command
     Mockup::get_command(const string& name)
     {
+	std::lock_guard<std::mutex> lock(mutex);
+
 	map<string, Command>::const_iterator it = commands.find(name);
 	if (it == commands.end())
 	    ST_THROW(Exception("no mockup found for command '" + name + "'"));
@@ -195,6 +203,8 @@ namespace storage
     void
     Mockup::set_command(const string& name, const Command& command)
     {
+	std::lock_guard<std::mutex> lock(mutex);
+
 	commands[name] = command;
     }
 
@@ -202,6 +212,8 @@ namespace storage
     void
     Mockup::set_command(const vector<string>& name, const Command& command)
     {
+	std::lock_guard<std::mutex> lock(mutex);
+
 	commands[boost::join(name, " ")] = command;
     }
 
@@ -209,6 +221,8 @@ namespace storage
     void
     Mockup::erase_command(const string& name)
     {
+	std::lock_guard<std::mutex> lock(mutex);
+
 	commands.erase(name);
     }
 
@@ -216,13 +230,17 @@ namespace storage
     bool
     Mockup::has_file(const string& name)
     {
+	std::lock_guard<std::mutex> lock(mutex);
+
 	return files.find(name) != files.end();
     }
 
 
-    const Mockup::File&
+    Mockup::File
     Mockup::get_file(const string& name)
     {
+	std::lock_guard<std::mutex> lock(mutex);
+
 	map<string, File>::const_iterator it = files.find(name);
 	if (it == files.end())
 	    ST_THROW(Exception("no mockup found for file '" + name + "'"));
@@ -238,6 +256,8 @@ namespace storage
     void
     Mockup::set_file(const string& name, const File& file)
     {
+	std::lock_guard<std::mutex> lock(mutex);
+
 	files[name] = file;
     }
 
@@ -245,6 +265,8 @@ namespace storage
     void
     Mockup::erase_file(const string& name)
     {
+	std::lock_guard<std::mutex> lock(mutex);
+
 	files.erase(name);
     }
 
@@ -254,6 +276,8 @@ namespace storage
     {
 #ifdef OCCAMS_RAZOR
 
+	std::lock_guard<std::mutex> lock(mutex);
+
 	bool ok = true;
 
 	for (const map<string, Command>::value_type& tmp : commands)
@@ -283,6 +307,8 @@ namespace storage
 
     Mockup::Mode Mockup::mode = Mockup::Mode::NONE;
 
+    std::mutex Mockup::mutex;
+
     map<string, Mockup::Command> Mockup::commands;
     map<string, Mockup::File> Mockup::files;
 
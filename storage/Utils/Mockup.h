@@ -29,6 +29,7 @@
 #include <vector>
 #include <map>
 #include <set>
+#include <mutex>
 
 #include "storage/Utils/Remote.h"
 
@@ -53,6 +54,10 @@ namespace storage
     using std::set;
 
 
+    /**
+     * The mockup commands and files may be queried and recorded from
+     * several threads at once, e.g. by actions committed in parallel.
+     */
     class Mockup
     {
     public:
@@ -72,13 +77,13 @@ namespace storage
 	static void save(const string& filename);
 
 	static bool has_command(const string& name);
-	static const Command& get_command(const string& name);
+	static Command get_command(const string& name);
 	static void set_command(const string& name, const Command& command);
 	static void set_command(const vector<string>& name, const Command& command);
 	static void erase_command(const string& name);
 
 	static bool has_file(const string& name);
-	static const File& get_file(const string& name);
+	static File get_file(const string& name);
 	static void set_file(const string& name, const File& file);
 	static void erase_file(const string& name);
 
@@ -88,6 +93,8 @@ namespace storage
 
 	static Mode mode;
 
+	static std::mutex mutex;
+
 	static map<string, Command> commands;
 	static map<string, File> files;
 
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2026 SUSE LLC
+ *
+ * All Rights Reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of version 2 of the GNU General Public License as published
+ * by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, contact Novell, Inc.
+ *
+ * To contact Novell about this file by physical or electronic mail, you may
+ * find current contact information at www.novell.com.
+ */
+
+
+#include <mutex>
+#include <new>
+
+#include "storage/Utils/ObjectPool.h"
+
+
+namespace storage
+{
+
+    using namespace std;
+
+
+    namespace
+    {
+
+	// Block sizes are multiples of the granularity which also guarantees
+	// the alignment required for new.
+
+	const size_t granularity = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+	const size_t max_block_size = 1024;
+
+	const size_t chunk_size = 64 * 1024;
+
+
+	struct FreeBlock
+	{
+	    FreeBlock* next;
+	};
+
+
+	class PoolImpl
+	{
+	public:
+
+	    void* allocate(size_t size)
+	    {
+		const size_t i = size_class(size);
+
+		lock_guard<mutex> lock(mtx);
+
+		if (!free_lists[i])
+		    add_chunk(i);
+
+		FreeBlock* block = free_lists[i];
+		free_lists[i] = block->next;
+		return block;
+	    }
+
+	    void deallocate(void* ptr, size_t size) noexcept
+	    {
+		const size_t i = size_class(size);
+
+		lock_guard<mutex> lock(mtx);
+
+		FreeBlock* block = static_cast<FreeBlock*>(ptr);
+		block->next = free_lists[i];
+		free_lists[i] = block;
+	    }
+
+	private:
+
+	    static size_t size_class(size_t size)
+	    {
+		return size == 0 ? 0 : (size - 1) / granularity;
+	    }
+
+	    void add_chunk(size_t i)
+	    {
+		const size_t block_size = (i + 1) * granularity;
+
+		char* chunk = static_cast<char*>(::operator new(chunk_size));
+
+		for (size_t offset = 0; offset + block_size <= chunk_size; offset += block_size)
+		{
+		    FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + offset);
+		    block->next = free_lists[i];
+		    free_lists[i] = block;
+		}
+	    }
+
+	    mutex mtx;
+
+	    FreeBlock* free_lists[max_block_size / granularity] = {};
+
+	};
+
+
+	PoolImpl&
+	get_pool()
+	{
+	    // Intentionally never destroyed since objects allocated from the
+	    // pool might be freed during program exit, e.g. by a static
+	    // Storage object.
+
+	    static PoolImpl* pool = new PoolImpl();
+	    return *pool;
+	}
+
+    }
+
+
+    void*
+    ObjectPool::allocate(size_t size)
+    {
+	if (size > max_block_size)
+	    return ::operator new(size);
+
+	return get_pool().allocate(size);
+    }
+
+
+    void
+    ObjectPool::deallocate(void* ptr, size_t size) noexcept
+    {
+	if (!ptr)
+	    return;
+
+	if (size > max_block_size)
+	{
+	    ::operator delete(ptr);
+	    return;
+	}
+
+	get_pool().deallocate(ptr, size);
+    }
+
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2026 SUSE LLC
+ *
+ * All Rights Reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of version 2 of the GNU General Public License as published
+ * by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, contact Novell, Inc.
+ *
+ * To contact Novell about this file by physical or electronic mail, you may
+ * find current contact information at www.novell.com.
+ */
+
+
+#ifndef STORAGE_OBJECT_POOL_H
+#define STORAGE_OBJECT_POOL_H
+
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+
+namespace storage
+{
+
+    /**
+     * Pool for the many small internal objects of devicegraphs (the
+     * implementations of devices and holders and the control blocks of the
+     * shared pointers holding the devices and holders). Only used
+     * internally, the classes of the public API use the global operator
+     * new.
+     *
+     * Memory is managed in chunks split into blocks of equal size. Freed
+     * blocks are kept in per size free lists and reused. So allocating and
+     * freeing is cheap and the objects of a devicegraph are close together.
+     * Memory is never returned to the system. Large requests are passed on
+     * to the global operator new.
+     *
+     * The functions are thread-safe.
+     */
+    class ObjectPool
+    {
+    public:
+
+	static void* allocate(size_t size);
+
+	/**
+	 * Size must be the same as used for allocate().
+	 */
+	static void deallocate(void* ptr, size_t size) noexcept;
+
+    };
+
+
+    /**
+     * Allocator using the ObjectPool. Intended for std::allocate_shared.
+     */
+    template <typename Type>
+    class ObjectPoolAllocator
+    {
+    public:
+
+	using value_type = Type;
+
+	ObjectPoolAllocator() noexcept = default;
+
+	template <typename Other>
+	ObjectPoolAllocator(const ObjectPoolAllocator<Other>&) noexcept {}
+
+	Type* allocate(size_t n) { return static_cast<Type*>(ObjectPool::allocate(n * sizeof(Type))); }
+	void deallocate(Type* ptr, size_t n) noexcept { ObjectPool::deallocate(ptr, n * sizeof(Type)); }
+
+	template <typename Other>
+	bool operator==(const ObjectPoolAllocator<Other>&) const noexcept { return true; }
+
+	template <typename Other>
+	bool operator!=(const ObjectPoolAllocator<Other>&) const noexcept { return false; }
+
+    };
+
+
+    /**
+     * Like std::make_shared but with the memory from the ObjectPool.
+     */
+    template <typename Type, typename... Args>
+    std::shared_ptr<Type>
+    make_pooled(Args&&... args)
+    {
+	return std::allocate_shared<Type>(ObjectPoolAllocator<Type>(), std::forward<Args>(args)...);
+    }
+
+
+    /**
+     * Takes ownership of ptr. The control block of the shared pointer is
+     * allocated from the ObjectPool.
+     */
+    template <typename Type>
+    std::shared_ptr<Type>
+    to_pooled(std::unique_ptr<Type>&& ptr)
+    {
+	return std::shared_ptr<Type>(ptr.release(), std::default_delete<Type>(), ObjectPoolAllocator<Type>());
+    }
+
+}
+
+#endif
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026 SUSE LLC
+ *
+ * All Rights Reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of version 2 of the GNU General Public License as published
+ * by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, contact Novell, Inc.
+ *
+ * To contact Novell about this file by physical or electronic mail, you may
+ * find current contact information at www.novell.com.
+ */
+
+
+#include "storage/Utils/Statistics.h"
+
+
+namespace storage
+{
+    using namespace std;
+
+
+    atomic<bool> Statistics::enabled(false);
+
+    atomic<unsigned long long> Statistics::counters[Statistics::num_counters];
+
+    atomic<unsigned long long> Statistics::nanoseconds[Statistics::num_counters];
+
+
+    void
+    Statistics::set_enabled(bool enabled)
+    {
+	Statistics::enabled.store(enabled, memory_order_relaxed);
+    }
+
+
+    void
+    Statistics::add_time(Counter counter, double seconds)
+    {
+	nanoseconds[(size_t)(counter)].fetch_add(seconds * 1e9, memory_order_relaxed);
+    }
+
+
+    DevicegraphStatistics
+    Statistics::get()
+    {
+	auto value = [](const atomic<unsigned long long>* values, Counter counter) {
+	    return values[(size_t)(counter)].load(memory_order_relaxed);
+	};
+
+	DevicegraphStatistics ret;
+
+	ret.find_vertex = value(counters, Counter::FIND_VERTEX);
+	ret.find_edges = value(counters, Counter::FIND_EDGES);
+	ret.traversals = value(counters, Counter::TRAVERSAL);
+	ret.dynamic_casts = value(counters, Counter::DYNAMIC_CAST);
+	ret.copies = value(counters, Counter::COPY);
+
+	ret.traversal_time = value(nanoseconds, Counter::TRAVERSAL) * 1e-9;
+	ret.copy_time = value(nanoseconds, Counter::COPY) * 1e-9;
+
+	return ret;
+    }
+
+
+    void
+    Statistics::reset()
+    {
+	for (size_t i = 0; i < num_counters; ++i)
+	{
+	    counters[i].store(0, memory_order_relaxed);
+	    nanoseconds[i].store(0, memory_order_relaxed);
+	}
+    }
+
+}
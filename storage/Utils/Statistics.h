@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2026 SUSE LLC
+ *
+ * All Rights Reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of version 2 of the GNU General Public License as published
+ * by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, contact Novell, Inc.
+ *
+ * To contact Novell about this file by physical or electronic mail, you may
+ * find current contact information at www.novell.com.
+ */
+
+
+#ifndef STORAGE_STATISTICS_H
+#define STORAGE_STATISTICS_H
+
+
+#include <atomic>
+#include <chrono>
+
+#include "storage/Storage.h"
+
+
+namespace storage
+{
+
+    /**
+     * Process-wide counters for devicegraph queries. Counting is disabled
+     * by default. The functions are thread-safe.
+     *
+     * @see Storage::get_devicegraph_statistics()
+     */
+    class Statistics
+    {
+    public:
+
+	enum class Counter
+	{
+	    FIND_VERTEX, FIND_EDGES, TRAVERSAL, DYNAMIC_CAST, COPY
+	};
+
+	static bool is_enabled() { return enabled.load(std::memory_order_relaxed); }
+	static void set_enabled(bool enabled);
+
+	static void count(Counter counter, unsigned long long n = 1)
+	{
+	    if (is_enabled())
+		counters[(size_t)(counter)].fetch_add(n, std::memory_order_relaxed);
+	}
+
+	static void add_time(Counter counter, double seconds);
+
+	static DevicegraphStatistics get();
+
+	static void reset();
+
+    private:
+
+	static const size_t num_counters = (size_t)(Counter::COPY) + 1;
+
+	static std::atomic<bool> enabled;
+	static std::atomic<unsigned long long> counters[num_counters];
+	static std::atomic<unsigned long long> nanoseconds[num_counters];
+
+    };
+
+
+    /**
+     * Counts the event on construction and adds the time until destruction
+     * if statistics are enabled. The clock is only read if statistics are
+     * enabled on construction.
+     */
+    class StatisticsStopwatch
+    {
+    public:
+
+	StatisticsStopwatch(Statistics::Counter counter)
+	    : counter(counter), enabled(Statistics::is_enabled())
+	{
+	    if (enabled)
+	    {
+		Statistics::count(counter);
+		start_time = std::chrono::steady_clock::now();
+	    }
+	}
+
+	~StatisticsStopwatch()
+	{
+	    if (enabled)
+	    {
+		std::chrono::steady_clock::duration duration = std::chrono::steady_clock::now() - start_time;
+		Statistics::add_time(counter, std::chrono::duration<double>(duration).count());
+	    }
+	}
+
+    private:
+
+	const Statistics::Counter counter;
+	const bool enabled;
+
+	std::chrono::steady_clock::time_point start_time;
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026 SUSE LLC
+ *
+ * All Rights Reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of version 2 of the GNU General Public License as published
+ * by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, contact Novell, Inc.
+ *
+ * To contact Novell about this file by physical or electronic mail, you may
+ * find current contact information at www.novell.com.
+ */
+
+
+
+#include "storage/Utils/WorkerPool.h"
+
+
+namespace storage
+{
+
+    using namespace std;
+
+
+    WorkerPool::WorkerPool(unsigned int size)
+    {
+	for (unsigned int i = 0; i < size; ++i)
+	    threads.emplace_back(&WorkerPool::work, this);
+    }
+
+
+    WorkerPool::~WorkerPool()
+    {
+	{
+	    lock_guard<mutex> lock(jobs_mutex);
+	    stopping = true;
+	}
+
+	jobs_condition.notify_all();
+
+	for (thread& thread : threads)
+	    thread.join();
+    }
+
+
+    void
+    WorkerPool::submit(function<void()> job)
+    {
+	{
+	    lock_guard<mutex> lock(jobs_mutex);
+	    jobs.push_back(std::move(job));
+	}
+
+	jobs_condition.notify_one();
+    }
+
+
+    void
+    WorkerPool::work()
+    {
+	while (true)
+	{
+	    function<void()> job;
+
+	    {
+		unique_lock<mutex> lock(jobs_mutex);
+
+		jobs_condition.wait(lock, [this]() { return stopping || !jobs.empty(); });
+
+		if (jobs.empty())
+		    return;
+
+		job = std::move(jobs.front());
+		jobs.pop_front();
+	    }
+
+	    job();
+	}
+    }
+
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026 SUSE LLC
+ *
+ * All Rights Reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of version 2 of the GNU General Public License as published
+ * by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, contact Novell, Inc.
+ *
+ * To contact Novell about this file by physical or electronic mail, you may
+ * find current contact information at www.novell.com.
+ */
+
+
+
+#ifndef STORAGE_WORKER_POOL_H
+#define STORAGE_WORKER_POOL_H
+
+
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <boost/noncopyable.hpp>
+
+
+namespace storage
+{
+
+    /**
+     * A fixed number of threads running submitted jobs in submission
+     * order. The destructor waits for all submitted jobs to finish.
+     *
+     * Jobs must not throw exceptions.
+     */
+    class WorkerPool : private boost::noncopyable
+    {
+    public:
+
+	WorkerPool(unsigned int size);
+	~WorkerPool();
+
+	void submit(std::function<void()> job);
+
+    private:
+
+	void work();
+
+	std::mutex jobs_mutex;
+	std::condition_variable jobs_condition;
+
+	std::deque<std::function<void()>> jobs;
+
+	bool stopping = false;
+
+	std::vector<std::thread> threads;
+
+    };
+
+}
+
+#endif
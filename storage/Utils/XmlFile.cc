@@ -74,6 +74,129 @@ namespace storage
     }
 
 
+    XmlFileReader::XmlFileReader(const string& filename)
+	: filename(filename), reader(xmlReaderForFile(filename.c_str(), NULL, XML_PARSE_NOBLANKS |
+							 XML_PARSE_NONET))
+    {
+	if (!reader)
+	    ST_THROW(Exception("failed to load xml document " + filename));
+    }
+
+
+    XmlFileReader::~XmlFileReader()
+    {
+	xmlFreeTextReader(reader);
+    }
+
+
+    bool
+    XmlFileReader::check(int ret) const
+    {
+	if (ret < 0)
+	    ST_THROW(Exception("failed to load xml document " + filename));
+
+	return ret == 1;
+    }
+
+
+    bool
+    XmlFileReader::read()
+    {
+	return check(xmlTextReaderRead(reader));
+    }
+
+
+    bool
+    XmlFileReader::next()
+    {
+	return check(xmlTextReaderNext(reader));
+    }
+
+
+    bool
+    XmlFileReader::is_element() const
+    {
+	return xmlTextReaderNodeType(reader) == XML_READER_TYPE_ELEMENT;
+    }
+
+
+    int
+    XmlFileReader::get_depth() const
+    {
+	return xmlTextReaderDepth(reader);
+    }
+
+
+    const char*
+    XmlFileReader::get_name() const
+    {
+	return (const char*) xmlTextReaderConstName(reader);
+    }
+
+
+    const xmlNode*
+    XmlFileReader::expand()
+    {
+	const xmlNode* node = xmlTextReaderExpand(reader);
+	if (!node)
+	    ST_THROW(Exception("failed to load xml document " + filename));
+
+	return node;
+    }
+
+
+    XmlFileWriter::XmlFileWriter(const string& filename)
+	: output(xmlOutputBufferCreateFilename(filename.c_str(), NULL, 0))
+    {
+	if (!output)
+	    error = true;
+    }
+
+
+    XmlFileWriter::~XmlFileWriter()
+    {
+	if (output)
+	    xmlOutputBufferClose(output);
+    }
+
+
+    void
+    XmlFileWriter::write(const char* text)
+    {
+	if (output && xmlOutputBufferWriteString(output, text) < 0)
+	    error = true;
+    }
+
+
+    void
+    XmlFileWriter::write(const xmlNode* node, int level)
+    {
+	if (!output)
+	    return;
+
+	// xmlNodeDumpOutput() does not indent the node itself.
+
+	write(string(2 * level, ' '));
+	xmlNodeDumpOutput(output, NULL, const_cast<xmlNode*>(node), level, 1, NULL);
+	write("\n");
+    }
+
+
+    bool
+    XmlFileWriter::close()
+    {
+	if (output)
+	{
+	    if (xmlOutputBufferClose(output) < 0)
+		error = true;
+
+	    output = nullptr;
+	}
+
+	return !error;
+    }
+
+
     xmlNode*
     xmlNewNode(const char* name)
     {
@@ -26,6 +26,8 @@
 
 
 #include <libxml/tree.h>
+#include <libxml/xmlreader.h>
+#include <cstdlib>
 #include <string>
 #include <vector>
 #include <sstream>
@@ -68,6 +70,89 @@ namespace storage
     };
 
 
+    /**
+     * Reads an XML file node by node without building the complete document
+     * in memory. Only the subtree of the current element can be expanded.
+     */
+    class XmlFileReader : private boost::noncopyable
+    {
+
+    public:
+
+	XmlFileReader(const string& filename);
+
+	~XmlFileReader();
+
+	/**
+	 * Moves to the next node. Returns false at the end of the document.
+	 */
+	bool read();
+
+	/**
+	 * Moves to the next node skipping the subtree of the current
+	 * node. Returns false at the end of the document.
+	 */
+	bool next();
+
+	bool is_element() const;
+
+	int get_depth() const;
+
+	const char* get_name() const;
+
+	/**
+	 * Returns the subtree of the current element. The subtree is only valid
+	 * until the reader is moved.
+	 */
+	const xmlNode* expand();
+
+    private:
+
+	bool check(int ret) const;
+
+	const string filename;
+
+	xmlTextReader* reader;
+
+    };
+
+
+    /**
+     * Writes an XML file piece by piece without building the complete document
+     * in memory. The output is formatted like XmlFile::save_to_file().
+     */
+    class XmlFileWriter : private boost::noncopyable
+    {
+
+    public:
+
+	XmlFileWriter(const string& filename);
+
+	~XmlFileWriter();
+
+	void write(const char* text);
+	void write(const string& text) { write(text.c_str()); }
+
+	/**
+	 * Writes the node including its subtree followed by a newline. Level
+	 * is the indentation level of the node.
+	 */
+	void write(const xmlNode* node, int level);
+
+	/**
+	 * Flushes and closes the file. Returns false if any error occurred.
+	 */
+	bool close();
+
+    private:
+
+	xmlOutputBuffer* output;
+
+	bool error = false;
+
+    };
+
+
     xmlNode* xmlNewNode(const char* name);
     xmlNode* xmlNewComment(const char* content);
 
@@ -93,9 +178,13 @@ namespace storage
 	if (!getChildValue(node, name, tmp))
 	    return false;
 
-	std::istringstream istr(tmp);
-	classic(istr);
-	istr >> std::setbase(0) >> value;
+	// Same as std::setbase(0) on a stream but without constructing a stream.
+
+	if (std::is_signed<Type>::value)
+	    value = std::strtoll(tmp.c_str(), nullptr, 0);
+	else
+	    value = std::strtoull(tmp.c_str(), nullptr, 0);
+
 	return true;
     }
 
@@ -127,10 +216,7 @@ namespace storage
     {
 	static_assert(std::is_integral<Type>::value, "not integral");
 
-	std::ostringstream ostr;
-	classic(ostr);
-	ostr << value;
-	setChildValue(node, name, ostr.str());
+	setChildValue(node, name, std::to_string(value));
     }
 
 
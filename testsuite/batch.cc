@@ -0,0 +1,134 @@
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE libstorage
+
+#include <boost/test/unit_test.hpp>
+
+#include "storage/Devices/DiskImpl.h"
+#include "storage/Devices/GptImpl.h"
+#include "storage/Devices/PartitionImpl.h"
+#include "storage/Filesystems/Ext4Impl.h"
+#include "storage/Environment.h"
+#include "storage/Storage.h"
+#include "storage/DevicegraphImpl.h"
+#include "storage/Utils/HumanString.h"
+
+
+using namespace std;
+using namespace storage;
+
+
+void
+add_disk(Devicegraph* devicegraph, const string& name)
+{
+    Disk* disk = Disk::create(devicegraph, name, 1 * TiB);
+    Gpt* gpt = to_gpt(disk->create_partition_table(PtType::GPT));
+
+    for (int i = 0; i < 4; ++i)
+    {
+	Partition* partition = gpt->create_partition(name + to_string(i + 1), Region(2048 + i * 1048576, 1048576, 512),
+						     PartitionType::PRIMARY);
+	partition->create_blk_filesystem(FsType::EXT4);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(batch)
+{
+    Environment environment(true, ProbeMode::NONE, TargetMode::DIRECT);
+
+    Storage storage(environment);
+
+    Devicegraph* staging = storage.get_staging();
+
+    {
+	Devicegraph::Batch batch(staging);
+
+	add_disk(staging, "/dev/sda");
+	add_disk(staging, "/dev/sdb");
+	add_disk(staging, "/dev/sdc");
+
+	// Removing devices within a batch defers updating the type buckets
+	// but using them must give the correct result.
+
+	staging->remove_devices(Disk::find_by_name(staging, "/dev/sdb")->get_descendants(true));
+
+	BOOST_CHECK_EQUAL(staging->get_impl().get_devices_of_type<const Disk>().size(), 2);
+
+	Disk::find_by_name(staging, "/dev/sdc")->remove_descendants(View::CLASSIC);
+
+	batch.commit();
+    }
+
+    BOOST_CHECK_EQUAL(staging->num_devices(), 1 + 1 + 4 + 4 + 1);
+    BOOST_CHECK_EQUAL(staging->num_holders(), 1 + 4 + 4);
+
+    BOOST_CHECK_EQUAL(staging->get_impl().get_devices_of_type<const Partition>().size(), 4);
+    BOOST_CHECK_EQUAL(staging->get_impl().get_devices_of_type<const BlkFilesystem>().size(), 4);
+
+    BOOST_CHECK(staging->find_device(Disk::find_by_name(staging, "/dev/sda")->get_sid()));
+    BOOST_CHECK_THROW(Disk::find_by_name(staging, "/dev/sdb"), DeviceNotFound);
+    BOOST_CHECK(Disk::find_by_name(staging, "/dev/sdc")->get_children().empty());
+}
+
+
+BOOST_AUTO_TEST_CASE(nested)
+{
+    Environment environment(true, ProbeMode::NONE, TargetMode::DIRECT);
+
+    Storage storage(environment);
+
+    Devicegraph* staging = storage.get_staging();
+
+    add_disk(staging, "/dev/sda");
+
+    {
+	Devicegraph::Batch outer(staging);
+
+	{
+	    Devicegraph::Batch inner(staging);
+
+	    Disk::find_by_name(staging, "/dev/sda")->remove_descendants(View::CLASSIC);
+	}
+
+	BOOST_CHECK(staging->get_impl().in_batch());
+    }
+
+    BOOST_CHECK(!staging->get_impl().in_batch());
+
+    BOOST_CHECK_EQUAL(staging->num_devices(), 1);
+    BOOST_CHECK_EQUAL(staging->num_holders(), 0);
+    BOOST_CHECK_EQUAL(staging->get_impl().get_devices_of_type<const Partition>().size(), 0);
+
+    staging->check();
+}
+
+
+BOOST_AUTO_TEST_CASE(left_by_exception)
+{
+    Environment environment(true, ProbeMode::NONE, TargetMode::DIRECT);
+
+    Storage storage(environment);
+
+    Devicegraph* staging = storage.get_staging();
+
+    add_disk(staging, "/dev/sda");
+
+    // Leaving the batch due to an exception must end the batch without
+    // throwing from the destructor.
+
+    BOOST_CHECK_THROW({
+	Devicegraph::Batch batch(staging);
+
+	Disk::find_by_name(staging, "/dev/sda")->remove_descendants(View::CLASSIC);
+
+	Disk::find_by_name(staging, "/dev/sdb");
+    }, DeviceNotFound);
+
+    BOOST_CHECK(!staging->get_impl().in_batch());
+
+    BOOST_CHECK_EQUAL(staging->num_devices(), 1);
+    BOOST_CHECK_EQUAL(staging->get_impl().get_devices_of_type<const Partition>().size(), 0);
+
+    staging->check();
+}
@@ -0,0 +1,155 @@
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE libstorage
+
+#include <boost/test/unit_test.hpp>
+
+#include "storage/Devices/DiskImpl.h"
+#include "storage/Devices/GptImpl.h"
+#include "storage/Devices/PartitionImpl.h"
+#include "storage/Devices/LvmVgImpl.h"
+#include "storage/Devices/LvmLvImpl.h"
+#include "storage/Holders/User.h"
+#include "storage/Environment.h"
+#include "storage/Storage.h"
+#include "storage/DevicegraphImpl.h"
+#include "storage/Utils/HumanString.h"
+
+
+using namespace std;
+using namespace storage;
+
+
+class CheckCallbacksCounter : public CheckCallbacks
+{
+public:
+
+    virtual void error(const string& message) const override { ++errors; }
+
+    mutable int errors = 0;
+
+};
+
+
+BOOST_AUTO_TEST_CASE(cycle)
+{
+    Environment environment(true, ProbeMode::NONE, TargetMode::DIRECT);
+
+    Storage storage(environment);
+
+    Devicegraph* devicegraph = storage.get_staging();
+
+    Disk* sda = Disk::create(devicegraph, "/dev/sda", 1 * TiB);
+    Gpt* gpt = to_gpt(sda->create_partition_table(PtType::GPT));
+    Partition* sda1 = gpt->create_partition("/dev/sda1", Region(2048, 1048576, 512), PartitionType::PRIMARY);
+
+    BOOST_CHECK_NO_THROW(devicegraph->check());
+
+    // The following checks are incremental since nothing but the new holder
+    // changed.
+
+    User::create(devicegraph, sda1, sda);
+
+    BOOST_CHECK_THROW(devicegraph->check(), Exception);
+
+    // The failed check must not forget the new holder.
+
+    BOOST_CHECK_THROW(devicegraph->check(), Exception);
+
+    devicegraph->remove_holder(devicegraph->find_holder(sda1->get_sid(), sda->get_sid()));
+
+    BOOST_CHECK_NO_THROW(devicegraph->check());
+}
+
+
+BOOST_AUTO_TEST_CASE(callbacks)
+{
+    Environment environment(true, ProbeMode::NONE, TargetMode::DIRECT);
+
+    Storage storage(environment);
+
+    Devicegraph* devicegraph = storage.get_staging();
+
+    Disk* sda = Disk::create(devicegraph, "/dev/sda", 16 * GiB);
+
+    LvmVg* lvm_vg = LvmVg::create(devicegraph, "system");
+    lvm_vg->add_lvm_pv(sda);
+
+    LvmLv* lvm_lv = lvm_vg->create_lvm_lv("root", LvType::NORMAL, 8 * GiB);
+
+    {
+	CheckCallbacksCounter check_callbacks;
+	devicegraph->check(&check_callbacks);
+	BOOST_CHECK_EQUAL(check_callbacks.errors, 0);
+    }
+
+    // Only the logical volume changed but the volume group must be checked.
+
+    lvm_lv->set_size(32 * GiB);
+
+    {
+	CheckCallbacksCounter check_callbacks;
+	devicegraph->check(&check_callbacks);
+	BOOST_CHECK_EQUAL(check_callbacks.errors, 1);
+    }
+
+    // Errors are reported again even if nothing changed.
+
+    {
+	CheckCallbacksCounter check_callbacks;
+	devicegraph->check(&check_callbacks);
+	BOOST_CHECK_EQUAL(check_callbacks.errors, 1);
+    }
+
+    lvm_lv->set_size(8 * GiB);
+
+    {
+	CheckCallbacksCounter check_callbacks;
+	devicegraph->check(&check_callbacks);
+	BOOST_CHECK_EQUAL(check_callbacks.errors, 0);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(modification_through_kept_reference)
+{
+    Environment environment(true, ProbeMode::NONE, TargetMode::DIRECT);
+
+    Storage storage(environment);
+
+    Devicegraph* devicegraph = storage.get_staging();
+
+    Disk* sda = Disk::create(devicegraph, "/dev/sda", 16 * GiB);
+
+    LvmVg* lvm_vg = LvmVg::create(devicegraph, "system");
+    lvm_vg->add_lvm_pv(sda);
+
+    LvmLv* lvm_lv = lvm_vg->create_lvm_lv("root", LvType::NORMAL, 8 * GiB);
+
+    LvmLv::Impl& lvm_lv_impl = lvm_lv->get_impl();
+
+    {
+	CheckCallbacksCounter check_callbacks;
+	devicegraph->check(&check_callbacks);
+	BOOST_CHECK_EQUAL(check_callbacks.errors, 0);
+    }
+
+    // Modify the logical volume through the kept reference. The next
+    // check must find the error like a full check, here of a copy.
+
+    lvm_lv_impl.set_size(32 * GiB);
+
+    {
+	CheckCallbacksCounter check_callbacks;
+	devicegraph->check(&check_callbacks);
+	BOOST_CHECK_EQUAL(check_callbacks.errors, 1);
+    }
+
+    {
+	const Devicegraph* copy = storage.copy_devicegraph("staging", "copy");
+
+	CheckCallbacksCounter check_callbacks;
+	copy->check(&check_callbacks);
+	BOOST_CHECK_EQUAL(check_callbacks.errors, 1);
+    }
+}
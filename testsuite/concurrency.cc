@@ -0,0 +1,108 @@
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE libstorage
+
+#include <thread>
+#include <atomic>
+#include <boost/test/unit_test.hpp>
+
+#include "storage/Devices/DiskImpl.h"
+#include "storage/Devices/GptImpl.h"
+#include "storage/Devices/PartitionImpl.h"
+#include "storage/Filesystems/BlkFilesystemImpl.h"
+#include "storage/Environment.h"
+#include "storage/Storage.h"
+#include "storage/DevicegraphImpl.h"
+#include "storage/Utils/HumanString.h"
+
+
+using namespace std;
+using namespace storage;
+
+
+string
+disk_name(int i)
+{
+    return "/dev/disk" + to_string(i);
+}
+
+
+/**
+ * Runs find_by_name(), get_descendants() and get_all() from several threads
+ * on a devicegraph with empty caches and compares the results with the
+ * results of a single thread.
+ */
+BOOST_AUTO_TEST_CASE(concurrent_const_access)
+{
+    Environment environment(true, ProbeMode::NONE, TargetMode::DIRECT);
+
+    Storage storage(environment);
+
+    Devicegraph* staging = storage.get_staging();
+
+    const int n = 100;
+
+    for (int i = 0; i < n; ++i)
+    {
+	Disk* disk = Disk::create(staging, disk_name(i), 1 * TiB);
+	Gpt* gpt = to_gpt(disk->create_partition_table(PtType::GPT));
+
+	for (int j = 0; j < 4; ++j)
+	{
+	    Partition* partition = gpt->create_partition(disk_name(i) + "p" + to_string(j + 1),
+							 Region(2048 + j * 1048576, 1048576, 512),
+							 PartitionType::PRIMARY);
+	    partition->create_blk_filesystem(FsType::EXT4);
+	}
+    }
+
+    for (int round = 0; round < 10; ++round)
+    {
+	// A copy has empty caches so the threads race to fill them.
+
+	Devicegraph* copy = storage.copy_devicegraph("staging", "copy");
+	const Devicegraph* devicegraph = copy;
+
+	atomic<int> failures(0);
+
+	vector<thread> threads;
+
+	for (int t = 0; t < 8; ++t)
+	{
+	    threads.emplace_back([devicegraph, t, &failures]() {
+		for (int i = 0; i < n; ++i)
+		{
+		    const int k = (i + t * 13) % n;
+
+		    const Disk* disk = Disk::find_by_name(devicegraph, disk_name(k));
+		    if (disk->get_descendants(false).size() != 1 + 4 + 4)
+			++failures;
+
+		    if (Disk::get_all(devicegraph).size() != n)
+			++failures;
+
+		    if (devicegraph->get_impl().get_devices_of_type<const Partition>().size() != 4 * n)
+			++failures;
+
+		    if (BlkFilesystem::get_all(devicegraph).size() != 4 * n)
+			++failures;
+
+		    if (disk->get_partition_table()->get_partitions().size() != 4)
+			++failures;
+		}
+
+		if (*devicegraph != *devicegraph)
+		    ++failures;
+	    });
+	}
+
+	for (thread& thread : threads)
+	    thread.join();
+
+	BOOST_CHECK_EQUAL(failures, 0);
+
+	BOOST_CHECK(*copy == *staging);
+
+	storage.remove_devicegraph("copy");
+    }
+}
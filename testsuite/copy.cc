@@ -2,6 +2,7 @@
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MODULE libstorage
 
+#include <unistd.h>
 #include <boost/test/unit_test.hpp>
 
 #include "storage/Devices/Disk.h"
@@ -16,7 +17,7 @@
 #include "storage/Holders/Subdevice.h"
 #include "storage/Environment.h"
 #include "storage/Storage.h"
-#include "storage/Devicegraph.h"
+#include "storage/DevicegraphImpl.h"
 
 
 using namespace storage;
@@ -59,3 +60,129 @@ BOOST_AUTO_TEST_CASE(copy)
 
     devicegraph_copy->check();
 }
+
+
+BOOST_AUTO_TEST_CASE(copy_and_compare)
+{
+    Environment environment(true, ProbeMode::NONE, TargetMode::DIRECT);
+
+    Storage storage(environment);
+
+    Devicegraph* devicegraph = storage.get_staging();
+
+    Disk* sda = Disk::create(devicegraph, "/dev/sda");
+
+    Gpt* gpt = Gpt::create(devicegraph);
+    User* user = User::create(devicegraph, sda, gpt);
+
+    Partition* sda1 = Partition::create(devicegraph, "/dev/sda1", Region(0, 10, 512), PartitionType::PRIMARY);
+    Subdevice::create(devicegraph, gpt, sda1);
+
+    Devicegraph* devicegraph_copy = storage.copy_devicegraph("staging", "copy");
+
+    BOOST_CHECK(*devicegraph == *devicegraph_copy);
+
+    // Modifications must be detected and reverting them must make the
+    // devicegraphs equal again.
+
+    sda1->set_region(Region(0, 20, 512));
+
+    BOOST_CHECK(*devicegraph != *devicegraph_copy);
+
+    sda1->set_region(Region(0, 10, 512));
+
+    BOOST_CHECK(*devicegraph == *devicegraph_copy);
+
+    user->set_userdata({ { "hello", "world" } });
+
+    BOOST_CHECK(*devicegraph != *devicegraph_copy);
+
+    user->set_userdata({});
+
+    BOOST_CHECK(*devicegraph == *devicegraph_copy);
+
+    Ext4::create(devicegraph);
+
+    BOOST_CHECK(*devicegraph != *devicegraph_copy);
+}
+
+
+BOOST_AUTO_TEST_CASE(save_and_load)
+{
+    Environment environment(true, ProbeMode::NONE, TargetMode::DIRECT);
+
+    Storage storage(environment);
+
+    Devicegraph* devicegraph = storage.get_staging();
+
+    Disk* sda = Disk::create(devicegraph, "/dev/sda");
+
+    Gpt* gpt = Gpt::create(devicegraph);
+    User::create(devicegraph, sda, gpt);
+
+    Partition* sda1 = Partition::create(devicegraph, "/dev/sda1", Region(0, 10, 512), PartitionType::PRIMARY);
+    Subdevice::create(devicegraph, gpt, sda1);
+
+    Swap::create(devicegraph);
+
+    devicegraph->save("copy-save-and-load.xml");
+
+    Devicegraph* devicegraph_loaded = storage.create_devicegraph("loaded");
+    devicegraph_loaded->load("copy-save-and-load.xml", true);
+
+    BOOST_CHECK(*devicegraph == *devicegraph_loaded);
+
+    // An empty devicegraph has empty Devices and Holders elements.
+
+    Devicegraph* devicegraph_empty = storage.create_devicegraph("empty");
+    devicegraph_empty->save("copy-save-and-load.xml");
+
+    devicegraph_loaded->load("copy-save-and-load.xml", true);
+
+    BOOST_CHECK_EQUAL(devicegraph_loaded->num_devices(), 0);
+
+    unlink("copy-save-and-load.xml");
+}
+
+
+BOOST_AUTO_TEST_CASE(lazy_load)
+{
+    Environment environment(true, ProbeMode::NONE, TargetMode::DIRECT);
+
+    Storage storage(environment);
+
+    Devicegraph* devicegraph = storage.get_staging();
+
+    Disk* sda = Disk::create(devicegraph, "/dev/sda");
+
+    Gpt* gpt = Gpt::create(devicegraph);
+    User::create(devicegraph, sda, gpt);
+
+    Partition* sda1 = Partition::create(devicegraph, "/dev/sda1", Region(0, 10, 512), PartitionType::PRIMARY);
+    Subdevice::create(devicegraph, gpt, sda1);
+
+    Disk* sdb = Disk::create(devicegraph, "/dev/sdb");
+
+    devicegraph->save("copy-lazy-load.xml");
+
+    Devicegraph* devicegraph_loaded = storage.create_devicegraph("loaded");
+    devicegraph_loaded->load("copy-lazy-load.xml", true, true);
+
+    unlink("copy-lazy-load.xml");
+
+    const Devicegraph::Impl& impl = devicegraph_loaded->get_impl();
+
+    BOOST_CHECK_EQUAL(devicegraph_loaded->num_devices(), 4);
+    BOOST_CHECK_EQUAL(boost::num_vertices(impl.graph), 0);
+
+    // Finding a device only creates the devices connected to it.
+
+    BOOST_CHECK_EQUAL(devicegraph_loaded->find_device(sdb->get_sid())->get_displayname(), "/dev/sdb");
+    BOOST_CHECK_EQUAL(boost::num_vertices(impl.graph), 1);
+
+    BOOST_CHECK(devicegraph_loaded->find_device(sda1->get_sid())->has_parents());
+    BOOST_CHECK_EQUAL(boost::num_vertices(impl.graph), 4);
+    BOOST_CHECK_EQUAL(boost::num_edges(impl.graph), 2);
+
+    BOOST_CHECK(*devicegraph == *devicegraph_loaded);
+}
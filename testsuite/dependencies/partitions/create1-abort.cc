@@ -0,0 +1,59 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE libstorage
+
+#include <boost/test/unit_test.hpp>
+
+#include "storage/Utils/Logger.h"
+#include "storage/Utils/Mockup.h"
+#include "storage/Utils/StorageDefines.h"
+#include "storage/Environment.h"
+#include "storage/Devicegraph.h"
+#include "storage/Devices/Partition.h"
+#include "storage/Storage.h"
+
+
+using namespace std;
+using namespace storage;
+
+
+BOOST_AUTO_TEST_CASE(coalesced_create_aborted)
+{
+    setenv("LIBSTORAGE_OS_FLAVOUR", "suse", 1);
+
+    set_logger(get_stdout_logger());
+
+    Environment environment(true, ProbeMode::READ_DEVICEGRAPH, TargetMode::DIRECT);
+    environment.set_devicegraph_filename("create1-probed.xml");
+
+    Storage storage(environment);
+    storage.probe();
+    storage.get_staging()->load("create1-staging.xml");
+
+    storage.set_coalesce_partition_actions(true);
+
+    storage.calculate_actiongraph();
+
+    Mockup::set_mode(Mockup::Mode::PLAYBACK);
+    Mockup::load("create1-mockup.xml");
+
+    // Let finishing the first partition fail so that the commit is
+    // aborted. The other partitions are already created by the single
+    // parted call.
+
+    Mockup::set_command(UDEVADM_BIN " info /dev/sdb1", Mockup::Command({}, { "Error: injected" }, 1));
+
+    Mockup::set_command(UDEVADM_BIN " info /dev/sdb2", Mockup::Command({ "P: /devices/virtual/block/sdb/sdb2", "N: sdb2",
+	    "S: disk/by-partuuid/aaaaaaaa-0000-0000-0000-000000000002" }, {}, 0));
+    Mockup::set_command(UDEVADM_BIN " info /dev/sdb3", Mockup::Command({ "P: /devices/virtual/block/sdb/sdb3", "N: sdb3",
+	    "S: disk/by-partuuid/aaaaaaaa-0000-0000-0000-000000000003" }, {}, 0));
+
+    BOOST_CHECK_THROW(storage.commit(CommitOptions(false)), Exception);
+
+    // The other partitions must still be finished, including probing their
+    // uuids.
+
+    const Devicegraph* staging = storage.get_staging();
+
+    BOOST_CHECK_EQUAL(Partition::find_by_name(staging, "/dev/sdb2")->get_uuid(), "aaaaaaaa-0000-0000-0000-000000000002");
+    BOOST_CHECK_EQUAL(Partition::find_by_name(staging, "/dev/sdb3")->get_uuid(), "aaaaaaaa-0000-0000-0000-000000000003");
+}
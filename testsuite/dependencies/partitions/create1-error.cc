@@ -0,0 +1,79 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE libstorage
+
+#include <boost/test/unit_test.hpp>
+#include <boost/algorithm/string.hpp>
+
+#include "storage/Utils/Logger.h"
+#include "storage/Utils/Mockup.h"
+#include "storage/Utils/StorageDefines.h"
+#include "storage/Environment.h"
+#include "storage/Devicegraph.h"
+#include "storage/Storage.h"
+
+
+using namespace std;
+using namespace storage;
+
+
+namespace
+{
+
+    class ErrorCommitCallbacks : public CommitCallbacks
+    {
+    public:
+
+	virtual void message(const string& message) const override {}
+
+	virtual bool error(const string& message, const string& what) const override
+	{
+	    errors.push_back(what);
+	    return true;
+	}
+
+	mutable vector<string> errors;
+
+    };
+
+}
+
+
+BOOST_AUTO_TEST_CASE(coalesced_create_fails)
+{
+    setenv("LIBSTORAGE_OS_FLAVOUR", "suse", 1);
+
+    set_logger(get_stdout_logger());
+
+    Environment environment(true, ProbeMode::READ_DEVICEGRAPH, TargetMode::DIRECT);
+    environment.set_devicegraph_filename("create1-probed.xml");
+
+    Storage storage(environment);
+    storage.probe();
+    storage.get_staging()->load("create1-staging.xml");
+
+    storage.set_coalesce_partition_actions(true);
+
+    storage.calculate_actiongraph();
+
+    Mockup::set_mode(Mockup::Mode::PLAYBACK);
+    Mockup::load("create1-mockup.xml");
+
+    // Let the single parted call creating all three partitions fail.
+
+    Mockup::set_command(PARTED_BIN " --script --wipesignatures /dev/sdb unit s mkpart '' ext2 2048 2099199 "
+			"mkpart '' ext2 2099200 4196351 mkpart '' ext2 4196352 6293503",
+			Mockup::Command({}, { "Error: injected" }, 1));
+
+    ErrorCommitCallbacks commit_callbacks;
+
+    storage.commit(CommitOptions(false), &commit_callbacks);
+
+    // The failed parted call is reported for the first partition. Creating
+    // the other partitions must not be reported as successful.
+
+    BOOST_REQUIRE_EQUAL(commit_callbacks.errors.size(), 3);
+
+    BOOST_CHECK(!boost::contains(commit_callbacks.errors[0], "together with other partitions"));
+    BOOST_CHECK(boost::contains(commit_callbacks.errors[1], "together with other partitions"));
+    BOOST_CHECK(boost::contains(commit_callbacks.errors[2], "together with other partitions"));
+}
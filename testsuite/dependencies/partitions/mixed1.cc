@@ -0,0 +1,26 @@
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE libstorage
+
+#include <boost/test/unit_test.hpp>
+
+#include "storage/Utils/Logger.h"
+#include "testsuite/helpers/TsCmp.h"
+
+
+using namespace storage;
+
+
+BOOST_AUTO_TEST_CASE(dependencies)
+{
+    setenv("LIBSTORAGE_OS_FLAVOUR", "suse", 1);
+
+    set_logger(get_stdout_logger());
+
+    // Deleting a logical partition and creating two primary partitions on
+    // the same MS-DOS partition table. Only directly following actions of
+    // the same kind are coalesced, see the mockup.
+
+    TsCmpActiongraph cmp("mixed1", true, 1, true);
+    BOOST_CHECK_MESSAGE(cmp.ok(), cmp);
+}
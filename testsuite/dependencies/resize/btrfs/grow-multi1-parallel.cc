@@ -0,0 +1,334 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE libstorage
+
+#include <boost/test/unit_test.hpp>
+#include <boost/algorithm/string.hpp>
+
+#include "storage/Utils/Logger.h"
+#include "storage/Utils/Mockup.h"
+#include "storage/Utils/StorageDefines.h"
+#include "storage/Filesystems/Btrfs.h"
+#include "storage/Environment.h"
+#include "storage/Storage.h"
+#include "testsuite/helpers/TsCmp.h"
+
+
+using namespace std;
+using namespace storage;
+
+
+// Check growing the partitions of a multi-device btrfs with several actions
+// running in parallel. The partitions are on different disks so growing them
+// can run in parallel. Growing the btrfs affects both disks so it must run
+// alone.
+
+
+namespace
+{
+
+    const string grow_sdc1 = "Growing partition /dev/sdc1";
+    const string grow_sdd1 = "Growing partition /dev/sdd1";
+    const string grow_btrfs1 = "Growing /dev/sdc1 of btrfs";
+    const string grow_btrfs2 = "Growing /dev/sdd1 of btrfs";
+
+    const string parted_sdd = PARTED_BIN " --script --ignore-busy /dev/sdd unit s resizepart 1 23070719";
+
+
+    // Records the begin and end of actions and errors. All callbacks are
+    // called from the thread calling commit().
+
+    class RecordingCommitCallbacks : public CommitCallbacksV2
+    {
+    public:
+
+	RecordingCommitCallbacks(bool continue_on_error = true)
+	    : continue_on_error(continue_on_error) {}
+
+	virtual void message(const string& message) const override
+	{
+	    // The message with the text of the action follows begin_action().
+
+	    if (!current)
+		return;
+
+	    texts[current] = message;
+	    events.push_back("begin " + message);
+	    current = nullptr;
+	}
+
+	virtual bool error(const string& message, const string& what) const override
+	{
+	    events.push_back("error " + message);
+	    return continue_on_error;
+	}
+
+	virtual void begin_action(const Action::Base* action) const override
+	{
+	    current = action;
+	}
+
+	virtual void end_action(const Action::Base* action) const override
+	{
+	    events.push_back("end " + texts[action]);
+	}
+
+	const bool continue_on_error;
+
+	mutable const Action::Base* current = nullptr;
+	mutable map<const Action::Base*, string> texts;
+	mutable vector<string> events;
+
+    };
+
+
+    bool
+    starts_with_any(const string& text, const vector<string>& prefixes)
+    {
+	return any_of(prefixes.begin(), prefixes.end(), [&text](const string& prefix) {
+	    return boost::starts_with(text, prefix);
+	});
+    }
+
+
+    // Replays the events and returns for every begun action the actions
+    // running when it began. Also checks that every action ends exactly
+    // once after it began.
+
+    map<string, set<string>>
+    running_at_begin(const vector<string>& events)
+    {
+	map<string, set<string>> ret;
+
+	set<string> running;
+
+	for (const string& event : events)
+	{
+	    if (boost::starts_with(event, "begin "))
+	    {
+		const string text = event.substr(6);
+
+		BOOST_CHECK_MESSAGE(ret.find(text) == ret.end(), "begun twice: " << text);
+
+		ret[text] = running;
+		running.insert(text);
+	    }
+	    else if (boost::starts_with(event, "end "))
+	    {
+		const string text = event.substr(4);
+
+		BOOST_CHECK_MESSAGE(running.erase(text) == 1, "ended without running: " << text);
+	    }
+	}
+
+	BOOST_CHECK_MESSAGE(running.empty(), "not ended: " << boost::join(running, ", "));
+
+	return ret;
+    }
+
+
+    unique_ptr<Storage>
+    make_storage()
+    {
+	setenv("LIBSTORAGE_OS_FLAVOUR", "suse", 1);
+
+	Environment environment(true, ProbeMode::READ_DEVICEGRAPH, TargetMode::DIRECT);
+	environment.set_devicegraph_filename("grow-multi1-probed.xml");
+
+	unique_ptr<Storage> storage = make_unique<Storage>(environment);
+	storage->probe();
+	storage->get_staging()->load("grow-multi1-staging.xml");
+
+	// The mockup can only be loaded once, maybe already by TsCmpActiongraph.
+
+	Mockup::set_mode(Mockup::Mode::PLAYBACK);
+
+	if (!Mockup::has_command(parted_sdd))
+	    Mockup::load("grow-multi1-mockup.xml");
+
+	return storage;
+    }
+
+}
+
+
+BOOST_AUTO_TEST_CASE(parallel_actions)
+{
+    setenv("LIBSTORAGE_OS_FLAVOUR", "suse", 1);
+
+    set_logger(get_stdout_logger());
+
+    TsCmpActiongraph cmp("grow-multi1", true, 2);
+    BOOST_CHECK_MESSAGE(cmp.ok(), cmp);
+}
+
+
+BOOST_AUTO_TEST_CASE(independent_actions_overlap)
+{
+    unique_ptr<Storage> storage = make_storage();
+
+    storage->set_max_parallel_actions(2);
+    storage->calculate_actiongraph();
+
+    RecordingCommitCallbacks commit_callbacks;
+
+    storage->commit(CommitOptions(false), &commit_callbacks);
+
+    const map<string, set<string>> running = running_at_begin(commit_callbacks.events);
+
+    BOOST_REQUIRE_EQUAL(running.size(), 4);
+
+    // The partitions are on different disks. Whichever is started second
+    // must start while the first is running.
+
+    unsigned int overlaps = 0;
+
+    for (const map<string, set<string>>::value_type& value : running)
+    {
+	if (starts_with_any(value.first, { grow_sdc1, grow_sdd1 }) && !value.second.empty())
+	{
+	    BOOST_CHECK_EQUAL(value.second.size(), 1);
+	    BOOST_CHECK(starts_with_any(*value.second.begin(), { grow_sdc1, grow_sdd1 }));
+	    ++overlaps;
+	}
+    }
+
+    BOOST_CHECK_EQUAL(overlaps, 1);
+}
+
+
+BOOST_AUTO_TEST_CASE(actions_on_shared_roots_are_serialized)
+{
+    unique_ptr<Storage> storage = make_storage();
+
+    storage->set_max_parallel_actions(4);
+    storage->calculate_actiongraph();
+
+    RecordingCommitCallbacks commit_callbacks;
+
+    storage->commit(CommitOptions(false), &commit_callbacks);
+
+    const map<string, set<string>> running = running_at_begin(commit_callbacks.events);
+
+    BOOST_REQUIRE_EQUAL(running.size(), 4);
+
+    // The btrfs is on both disks so growing it conflicts with all other
+    // actions.
+
+    for (const map<string, set<string>>::value_type& value : running)
+    {
+	if (starts_with_any(value.first, { grow_btrfs1, grow_btrfs2 }))
+	    BOOST_CHECK_MESSAGE(value.second.empty(), "not alone: " << value.first);
+
+	for (const string& tmp : value.second)
+	    BOOST_CHECK_MESSAGE(!starts_with_any(tmp, { grow_btrfs1, grow_btrfs2 }), "overlaps btrfs: " << value.first);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(barrier_runs_alone)
+{
+    unique_ptr<Storage> storage = make_storage();
+
+    // Setting the label is not a create, delete or resize action and thus
+    // a barrier.
+
+    Btrfs* btrfs = Btrfs::get_all(storage->get_staging()).front();
+    btrfs->set_label("test");
+
+    for (const string& name : { "/dev/sdc1", "/dev/sdd1" })
+	Mockup::set_command({ BTRFS_BIN, "filesystem", "label", name, "test" }, vector<string>({}));
+
+    storage->set_max_parallel_actions(4);
+    storage->calculate_actiongraph();
+
+    RecordingCommitCallbacks commit_callbacks;
+
+    storage->commit(CommitOptions(false), &commit_callbacks);
+
+    const vector<string>& events = commit_callbacks.events;
+
+    const map<string, set<string>> running = running_at_begin(events);
+
+    BOOST_REQUIRE_EQUAL(running.size(), 5);
+
+    vector<string>::const_iterator it = find_if(events.begin(), events.end(), [](const string& event) {
+	return boost::starts_with(event, "begin ") && boost::icontains(event, "label");
+    });
+
+    BOOST_REQUIRE(it != events.end());
+
+    const string text = it->substr(6);
+
+    BOOST_CHECK(running.at(text).empty());
+
+    // Nothing starts before the barrier is finished.
+
+    BOOST_REQUIRE(next(it) != events.end());
+    BOOST_CHECK_EQUAL(*next(it), "end " + text);
+}
+
+
+BOOST_AUTO_TEST_CASE(error_in_worker_continue)
+{
+    unique_ptr<Storage> storage = make_storage();
+
+    const Mockup::Command command = Mockup::get_command(parted_sdd);
+    Mockup::set_command(parted_sdd, Mockup::Command({}, { "Error: injected" }, 1));
+
+    storage->set_max_parallel_actions(2);
+    storage->calculate_actiongraph();
+
+    RecordingCommitCallbacks commit_callbacks(true);
+
+    BOOST_CHECK_NO_THROW(storage->commit(CommitOptions(false), &commit_callbacks));
+
+    Mockup::set_command(parted_sdd, command);
+
+    const vector<string>& events = commit_callbacks.events;
+
+    const map<string, set<string>> running = running_at_begin(events);
+
+    // The error is reported and the commit continues with all actions.
+
+    BOOST_CHECK_EQUAL(running.size(), 4);
+
+    BOOST_CHECK_EQUAL(count_if(events.begin(), events.end(), [](const string& event) {
+	return boost::starts_with(event, "error " + grow_sdd1);
+    }), 1);
+}
+
+
+BOOST_AUTO_TEST_CASE(error_in_worker_abort)
+{
+    unique_ptr<Storage> storage = make_storage();
+
+    const Mockup::Command command = Mockup::get_command(parted_sdd);
+    Mockup::set_command(parted_sdd, Mockup::Command({}, { "Error: injected" }, 1));
+
+    storage->set_max_parallel_actions(2);
+    storage->calculate_actiongraph();
+
+    RecordingCommitCallbacks commit_callbacks(false);
+
+    BOOST_CHECK_THROW(storage->commit(CommitOptions(false), &commit_callbacks), Aborted);
+
+    Mockup::set_command(parted_sdd, command);
+
+    const vector<string>& events = commit_callbacks.events;
+
+    // All running actions are finished (checked by running_at_begin())
+    // but no further action is started after the error.
+
+    running_at_begin(events);
+
+    vector<string>::const_iterator it = find_if(events.begin(), events.end(), [](const string& event) {
+	return boost::starts_with(event, "error ");
+    });
+
+    BOOST_REQUIRE(it != events.end());
+    BOOST_CHECK(boost::starts_with(*it, "error " + grow_sdd1));
+
+    BOOST_CHECK(none_of(it, events.end(), [](const string& event) {
+	return boost::starts_with(event, "begin ");
+    }));
+}
@@ -0,0 +1,27 @@
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE libstorage
+
+#include <boost/test/unit_test.hpp>
+
+#include "storage/Utils/Logger.h"
+#include "testsuite/helpers/TsCmp.h"
+
+
+using namespace storage;
+
+
+// Check shrinking the partition of a mounted ext4 while also changing the
+// path of its mount point. Both need an unmount and a mount of the same
+// mount point, the duplicates must be merged. The unmount and mount of the
+// other mount point must be kept.
+
+BOOST_AUTO_TEST_CASE(actions)
+{
+    setenv("LIBSTORAGE_OS_FLAVOUR", "suse", 1);
+
+    set_logger(get_stdout_logger());
+
+    TsCmpActiongraph cmp("shrink3");
+    BOOST_CHECK_MESSAGE(cmp.ok(), cmp);
+}
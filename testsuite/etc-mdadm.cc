@@ -61,6 +61,10 @@ BOOST_AUTO_TEST_CASE(update1)
 
     etc_mdadm.update_entry(entry);
 
+    check({ });
+
+    etc_mdadm.write();
+
     check({
 	"ARRAY /dev/md0 UUID=0a278ebc:9aea4c40:554a5f39:b52224a7"
     });
@@ -86,6 +90,8 @@ BOOST_AUTO_TEST_CASE(update2)
     etc_mdadm.update_entry(entry1);
     etc_mdadm.update_entry(entry2);
 
+    etc_mdadm.write();
+
     check({
 	"ARRAY metadata=imsm UUID=9087e240:1a2f2dfe:85189535:b0c0ebc5",
 	"ARRAY /dev/md/126 container=9087e240:1a2f2dfe:85189535:b0c0ebc5 member=0 UUID=24d20d34:3c2dc232:37f18a24:76282016"
@@ -105,6 +111,8 @@ BOOST_AUTO_TEST_CASE(remove1)
 
     etc_mdadm.remove_entry("0a278ebc:9aea4c40:554a5f39:b52224a7");
 
+    etc_mdadm.write();
+
     check({
         "DEVICE containers partitions",
         "ARRAY /dev/md1 UUID=0a1750eb:b5efbc17:b0bb6de2:b707a04f"
@@ -93,3 +93,126 @@ BOOST_AUTO_TEST_CASE(find_vertex)
 
     BOOST_CHECK_THROW(BlkDevice::find_by_any_name(system, "/dev/does-not-exist", system_info), DeviceNotFound);
 }
+
+
+BOOST_AUTO_TEST_CASE(find_vertex_by_sid)
+{
+    Environment environment(true, ProbeMode::NONE, TargetMode::DIRECT);
+
+    Storage storage(environment);
+
+    Devicegraph* staging = storage.get_staging();
+
+    Disk* sda = Disk::create(staging, "/dev/sda");
+    Disk* sdb = Disk::create(staging, "/dev/sdb");
+
+    const sid_t sda_sid = sda->get_sid();
+    const sid_t sdb_sid = sdb->get_sid();
+
+    BOOST_CHECK_EQUAL(staging->find_device(sda_sid), sda);
+    BOOST_CHECK_EQUAL(staging->find_device(sdb_sid), sdb);
+
+    // The sid index of a copied devicegraph must point to the copies.
+
+    Devicegraph* copy = storage.copy_devicegraph("staging", "copy");
+
+    BOOST_CHECK(copy->find_device(sda_sid) != sda);
+    BOOST_CHECK_EQUAL(to_disk(copy->find_device(sda_sid))->get_name(), "/dev/sda");
+
+    // Changing the sid must update the index.
+
+    sdb->get_impl().set_sid(sdb_sid + 1000);
+
+    BOOST_CHECK(!staging->device_exists(sdb_sid));
+    BOOST_CHECK_EQUAL(staging->find_device(sdb_sid + 1000), sdb);
+
+    // Removing a device must update the index.
+
+    staging->remove_device(sda);
+
+    BOOST_CHECK(!staging->device_exists(sda_sid));
+    BOOST_CHECK_THROW(staging->find_device(sda_sid), DeviceNotFoundBySid);
+
+    BOOST_CHECK(copy->device_exists(sda_sid));
+}
+
+
+BOOST_AUTO_TEST_CASE(find_by_name_after_changes)
+{
+    Environment environment(true, ProbeMode::NONE, TargetMode::DIRECT);
+
+    Storage storage(environment);
+
+    Devicegraph* staging = storage.get_staging();
+
+    Disk* sda = Disk::create(staging, "/dev/sda");
+
+    BOOST_CHECK_EQUAL(BlkDevice::find_by_name(staging, "/dev/sda"), sda);
+    BOOST_CHECK_THROW(BlkDevice::find_by_name(staging, "/dev/sdb"), DeviceNotFoundByName);
+
+    // Devices added after the lookup index was built must be found.
+
+    Disk* sdb = Disk::create(staging, "/dev/sdb");
+
+    BOOST_CHECK_EQUAL(BlkDevice::find_by_name(staging, "/dev/sdb"), sdb);
+
+    // Renamed devices must be found by the new name only.
+
+    sdb->set_name("/dev/sdc");
+
+    BOOST_CHECK_THROW(BlkDevice::find_by_name(staging, "/dev/sdb"), DeviceNotFoundByName);
+    BOOST_CHECK_EQUAL(BlkDevice::find_by_name(staging, "/dev/sdc"), sdb);
+
+    // Removed devices must not be found.
+
+    staging->remove_device(sda);
+
+    BOOST_CHECK_THROW(BlkDevice::find_by_name(staging, "/dev/sda"), DeviceNotFoundByName);
+
+    // Copies must find their own devices.
+
+    Devicegraph* copy = storage.copy_devicegraph("staging", "copy");
+
+    BlkDevice* sdc = BlkDevice::find_by_name(copy, "/dev/sdc");
+
+    BOOST_CHECK(sdc != sdb);
+    BOOST_CHECK_EQUAL(sdc->get_devicegraph(), copy);
+    BOOST_CHECK_EQUAL(sdc->get_sid(), sdb->get_sid());
+
+    sdc->set_name("/dev/sdd");
+
+    BOOST_CHECK_EQUAL(BlkDevice::find_by_name(copy, "/dev/sdd"), sdc);
+    BOOST_CHECK_EQUAL(BlkDevice::find_by_name(staging, "/dev/sdc"), sdb);
+
+    Disk::create(copy, "/dev/sde");
+
+    BOOST_CHECK_THROW(BlkDevice::find_by_name(staging, "/dev/sde"), DeviceNotFoundByName);
+}
+
+
+BOOST_AUTO_TEST_CASE(find_by_name_with_duplicates)
+{
+    Environment environment(true, ProbeMode::NONE, TargetMode::DIRECT);
+
+    Storage storage(environment);
+
+    Devicegraph* staging = storage.get_staging();
+
+    Disk* sda = Disk::create(staging, "/dev/sda");
+    Disk* sdb = Disk::create(staging, "/dev/sdb");
+
+    BOOST_CHECK_EQUAL(BlkDevice::find_by_name(staging, "/dev/sdb"), sdb);
+
+    // With duplicate names the device first in the order of the vertices
+    // is found, independent of the sids.
+
+    sda->get_impl().set_sid(sdb->get_sid() + 100);
+    sda->set_name("/dev/sdb");
+
+    BOOST_CHECK_EQUAL(BlkDevice::find_by_name(staging, "/dev/sdb"), sda);
+
+    sda->set_name("/dev/sda");
+
+    BOOST_CHECK_EQUAL(BlkDevice::find_by_name(staging, "/dev/sda"), sda);
+    BOOST_CHECK_EQUAL(BlkDevice::find_by_name(staging, "/dev/sdb"), sdb);
+}
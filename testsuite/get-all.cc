@@ -0,0 +1,142 @@
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE libstorage
+
+#include <boost/test/unit_test.hpp>
+
+#include "storage/Devices/DiskImpl.h"
+#include "storage/Devices/GptImpl.h"
+#include "storage/Devices/PartitionImpl.h"
+#include "storage/Devices/LvmPvImpl.h"
+#include "storage/Devices/LvmVgImpl.h"
+#include "storage/Devices/LvmLvImpl.h"
+#include "storage/Devices/LuksImpl.h"
+#include "storage/Devices/MdImpl.h"
+#include "storage/Filesystems/Ext4Impl.h"
+#include "storage/Filesystems/SwapImpl.h"
+#include "storage/Filesystems/BtrfsImpl.h"
+#include "storage/Filesystems/BtrfsSubvolumeImpl.h"
+#include "storage/Filesystems/MountPointImpl.h"
+#include "storage/Filesystems/NfsImpl.h"
+#include "storage/Filesystems/TmpfsImpl.h"
+#include "storage/DevicegraphImpl.h"
+#include "storage/Environment.h"
+#include "storage/Storage.h"
+#include "storage/Utils/HumanString.h"
+
+
+using namespace std;
+using namespace storage;
+
+
+/**
+ * Get all devices of Type using dynamic_cast. Used as reference.
+ */
+template <typename Type>
+vector<const Type*>
+get_all_by_dynamic_cast(const Devicegraph* devicegraph)
+{
+    vector<const Type*> ret;
+
+    for (const Device* device : devicegraph->get_impl().get_devices_of_type<const Device>())
+    {
+	const Type* tmp = dynamic_cast<const Type*>(device);
+	if (tmp)
+	    ret.push_back(tmp);
+    }
+
+    return ret;
+}
+
+
+template <typename Type>
+void
+check_get_all(const Devicegraph* devicegraph)
+{
+    vector<const Type*> lhs = devicegraph->get_impl().get_devices_of_type<const Type>();
+    vector<const Type*> rhs = get_all_by_dynamic_cast<Type>(devicegraph);
+
+    BOOST_CHECK_MESSAGE(lhs == rhs, "get_all mismatch for " << DeviceTraits<Type>::classname);
+}
+
+
+void
+check_all(const Devicegraph* devicegraph)
+{
+    check_get_all<BlkDevice>(devicegraph);
+    check_get_all<Partitionable>(devicegraph);
+    check_get_all<Disk>(devicegraph);
+    check_get_all<Md>(devicegraph);
+    check_get_all<Partition>(devicegraph);
+    check_get_all<PartitionTable>(devicegraph);
+    check_get_all<Gpt>(devicegraph);
+    check_get_all<LvmPv>(devicegraph);
+    check_get_all<LvmVg>(devicegraph);
+    check_get_all<LvmLv>(devicegraph);
+    check_get_all<Encryption>(devicegraph);
+    check_get_all<Luks>(devicegraph);
+    check_get_all<Mountable>(devicegraph);
+    check_get_all<Filesystem>(devicegraph);
+    check_get_all<BlkFilesystem>(devicegraph);
+    check_get_all<Ext>(devicegraph);
+    check_get_all<Ext4>(devicegraph);
+    check_get_all<Swap>(devicegraph);
+    check_get_all<Btrfs>(devicegraph);
+    check_get_all<BtrfsSubvolume>(devicegraph);
+    check_get_all<MountPoint>(devicegraph);
+    check_get_all<Nfs>(devicegraph);
+    check_get_all<Tmpfs>(devicegraph);
+}
+
+
+BOOST_AUTO_TEST_CASE(get_all)
+{
+    Environment environment(true, ProbeMode::NONE, TargetMode::DIRECT);
+
+    Storage storage(environment);
+
+    Devicegraph* staging = storage.get_staging();
+
+    Disk* sda = Disk::create(staging, "/dev/sda", 1 * TiB);
+    Gpt* gpt = to_gpt(sda->create_partition_table(PtType::GPT));
+
+    Partition* sda1 = gpt->create_partition("/dev/sda1", Region(2048, 1048576, 512), PartitionType::PRIMARY);
+    sda1->create_blk_filesystem(FsType::SWAP)->create_mount_point("swap");
+
+    Partition* sda2 = gpt->create_partition("/dev/sda2", Region(1050624, 20971520, 512), PartitionType::PRIMARY);
+    Btrfs* btrfs = to_btrfs(sda2->create_blk_filesystem(FsType::BTRFS));
+    btrfs->create_mount_point("/");
+    btrfs->get_top_level_btrfs_subvolume()->create_btrfs_subvolume("@/home");
+
+    Partition* sda3 = gpt->create_partition("/dev/sda3", Region(22022144, 20971520, 512), PartitionType::PRIMARY);
+    Encryption* encryption = sda3->create_encryption("cr-sda3", EncryptionType::LUKS2);
+
+    LvmVg* lvm_vg = LvmVg::create(staging, "system");
+    lvm_vg->add_lvm_pv(encryption);
+    LvmLv* lvm_lv = lvm_vg->create_lvm_lv("home", LvType::NORMAL, 2 * GiB);
+    lvm_lv->create_blk_filesystem(FsType::EXT4)->create_mount_point("/home");
+
+    Md* md0 = Md::create(staging, "/dev/md0");
+    md0->add_device(Disk::create(staging, "/dev/sdb", 1 * TiB));
+    md0->add_device(Disk::create(staging, "/dev/sdc", 1 * TiB));
+
+    Nfs::create(staging, "server", "/srv")->create_mount_point("/srv");
+    Tmpfs::create(staging)->create_mount_point("/tmp");
+
+    check_all(staging);
+
+    // Check that copying and removing keeps the buckets consistent.
+
+    Devicegraph* copy = storage.copy_devicegraph("staging", "copy");
+
+    check_all(copy);
+
+    staging->remove_device(lvm_vg);
+    staging->remove_device(encryption);
+    sda2->remove_descendants();
+
+    check_all(staging);
+
+    BOOST_CHECK(staging->get_impl().get_devices_of_type<const LvmVg>().empty());
+    BOOST_CHECK_EQUAL(copy->get_impl().get_devices_of_type<const LvmVg>().size(), 1);
+}
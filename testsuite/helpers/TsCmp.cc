@@ -194,7 +194,8 @@ namespace storage
     }
 
 
-    TsCmpActiongraph::TsCmpActiongraph(const string& name, bool commit)
+    TsCmpActiongraph::TsCmpActiongraph(const string& name, bool commit, unsigned int max_parallel_actions,
+				       bool coalesce_partition_actions)
     {
 	Environment environment(true, ProbeMode::READ_DEVICEGRAPH, TargetMode::DIRECT);
 	environment.set_devicegraph_filename(name + "-probed.xml");
@@ -236,6 +237,9 @@ namespace storage
 	Mockup::set_mode(Mockup::Mode::PLAYBACK);
 	Mockup::load(name + "-mockup.xml");
 
+	storage->set_max_parallel_actions(max_parallel_actions);
+	storage->set_coalesce_partition_actions(coalesce_partition_actions);
+
 	CommitOptions commit_options(false);
 
 	storage->commit(commit_options);
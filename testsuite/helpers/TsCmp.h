@@ -82,8 +82,12 @@ namespace storage
 	 * in the mockup file (otherwise an exception is raised). Due
 	 * to possible interaction of external programs and files this
 	 * is likely only useful for testing a few actions at once.
+	 *
+	 * The commit runs up to max_parallel_actions actions in parallel and
+	 * coalesces partition actions if coalesce_partition_actions is set.
 	 */
-	TsCmpActiongraph(const string& name, bool commit = false);
+	TsCmpActiongraph(const string& name, bool commit = false, unsigned int max_parallel_actions = 1,
+			 bool coalesce_partition_actions = false);
 
 	const Devicegraph* get_probed() const { return probed; }
 	const Devicegraph* get_staging() const { return staging; }
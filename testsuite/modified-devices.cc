@@ -0,0 +1,122 @@
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE libstorage
+
+#include <boost/test/unit_test.hpp>
+
+#include "storage/Devices/Disk.h"
+#include "storage/Devices/Gpt.h"
+#include "storage/Devices/Partition.h"
+#include "storage/Devices/LvmVg.h"
+#include "storage/Devices/LvmLv.h"
+#include "storage/Filesystems/BlkFilesystemImpl.h"
+#include "storage/Filesystems/MountPoint.h"
+#include "storage/Actions/Base.h"
+#include "storage/Actiongraph.h"
+#include "storage/Environment.h"
+#include "storage/Storage.h"
+#include "storage/Utils/HumanString.h"
+
+
+using namespace std;
+using namespace storage;
+
+
+vector<string>
+commit_actions(const Storage& storage, Devicegraph* lhs, Devicegraph* rhs)
+{
+    Actiongraph actiongraph(storage, lhs, rhs);
+
+    vector<string> ret;
+
+    for (const Action::Base* action : actiongraph.get_commit_actions())
+	ret.push_back(get_string(&actiongraph, action));
+
+    return ret;
+}
+
+
+BOOST_AUTO_TEST_CASE(modified_devices)
+{
+    Environment environment(true, ProbeMode::NONE, TargetMode::DIRECT);
+
+    Storage storage(environment);
+
+    Devicegraph* system = storage.get_system();
+
+    Disk* sda = Disk::create(system, "/dev/sda", 1 * TiB);
+    Gpt* gpt = to_gpt(sda->create_partition_table(PtType::GPT));
+
+    Partition* sda1 = gpt->create_partition("/dev/sda1", Region(2048, 1048576, 512), PartitionType::PRIMARY);
+    sda1->create_blk_filesystem(FsType::SWAP)->create_mount_point("swap");
+
+    Partition* sda2 = gpt->create_partition("/dev/sda2", Region(1050624, 20971520, 512), PartitionType::PRIMARY);
+    sda2->create_blk_filesystem(FsType::EXT4)->create_mount_point("/");
+
+    Partition* sda3 = gpt->create_partition("/dev/sda3", Region(22022144, 20971520, 512), PartitionType::PRIMARY);
+    LvmVg* lvm_vg = LvmVg::create(system, "system");
+    lvm_vg->add_lvm_pv(sda3);
+    LvmLv* lvm_lv = lvm_vg->create_lvm_lv("home", LvType::NORMAL, 2 * GiB);
+    lvm_lv->create_blk_filesystem(FsType::XFS)->create_mount_point("/home");
+
+    Disk* sdb = Disk::create(system, "/dev/sdb", 1 * TiB);
+    sdb->create_blk_filesystem(FsType::EXT4)->create_mount_point("/srv");
+
+    // An unmodified copy needs no actions.
+
+    Devicegraph* modified = storage.copy_devicegraph("system", "modified");
+
+    BOOST_CHECK(commit_actions(storage, system, modified).empty());
+
+    // Modify a few devices in the copy.
+
+    to_partition(modified->find_device(sda2->get_sid()))->get_blk_filesystem()->set_label("root");
+    to_partition(modified->find_device(sda1->get_sid()))->set_id(ID_SWAP);
+    to_disk(modified->find_device(sdb->get_sid()))->get_blk_filesystem()->get_mount_point()->set_path("/data");
+
+    const vector<string> actions = commit_actions(storage, system, modified);
+
+    BOOST_CHECK(!actions.empty());
+
+    const vector<string> expected = {
+	"Unmount /dev/sdb (1.00 TiB) at /srv",
+	"Update mount point /data of /dev/sdb (1.00 TiB) in /etc/fstab",
+	"Mount /dev/sdb (1.00 TiB) at /data",
+	"Set label of ext4 on /dev/sda2 (10.00 GiB) to root",
+	"Set id of partition /dev/sda1 to Linux Swap"
+    };
+
+    BOOST_CHECK_EQUAL_COLLECTIONS(actions.begin(), actions.end(), expected.begin(), expected.end());
+}
+
+
+BOOST_AUTO_TEST_CASE(modified_devices_kept_reference)
+{
+    Environment environment(true, ProbeMode::NONE, TargetMode::DIRECT);
+
+    Storage storage(environment);
+
+    Devicegraph* system = storage.get_system();
+
+    Disk* sda = Disk::create(system, "/dev/sda", 1 * TiB);
+    sda->create_blk_filesystem(FsType::EXT4);
+
+    Devicegraph* modified = storage.copy_devicegraph("system", "modified");
+
+    BOOST_CHECK(commit_actions(storage, system, modified).empty());
+
+    // Modifying the filesystem through a reference kept from before the
+    // copy must still be found.
+
+    BlkFilesystem::Impl& impl = to_disk(modified->find_device(sda->get_sid()))->get_blk_filesystem()->get_impl();
+
+    Devicegraph* copy = storage.copy_devicegraph("modified", "copy");
+
+    BOOST_CHECK(commit_actions(storage, copy, modified).empty());
+
+    impl.set_label("data");
+
+    const vector<string> actions = commit_actions(storage, copy, modified);
+
+    BOOST_CHECK_EQUAL(actions.size(), 1);
+}
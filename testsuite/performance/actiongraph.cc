@@ -0,0 +1,110 @@
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE libstorage
+
+#include <iostream>
+#include <boost/test/unit_test.hpp>
+
+#include "storage/Devices/Disk.h"
+#include "storage/Devices/PartitionTable.h"
+#include "storage/Devices/Partition.h"
+#include "storage/Filesystems/BlkFilesystem.h"
+#include "storage/Filesystems/MountPoint.h"
+#include "storage/Devicegraph.h"
+#include "storage/Actiongraph.h"
+#include "storage/Storage.h"
+#include "storage/Environment.h"
+#include "storage/Utils/HumanString.h"
+#include "storage/Utils/Stopwatch.h"
+
+
+using namespace std;
+using namespace storage;
+
+
+string
+disk_name(int i)
+{
+    return "/dev/disk" + to_string(i);
+}
+
+
+void
+add_disk(Devicegraph* devicegraph, int i)
+{
+    Disk::create(devicegraph, disk_name(i), 1 * TiB);
+}
+
+
+void
+add_partitions(Devicegraph* devicegraph, int i)
+{
+    Disk* disk = Disk::find_by_name(devicegraph, disk_name(i));
+
+    PartitionTable* partition_table = disk->create_partition_table(PtType::GPT);
+
+    for (int j = 1; j < 5; ++j)
+    {
+	Partition* partition = partition_table->create_partition(disk_name(i) + "p" + to_string(j),
+								 Region(j * 1048576, 1048576, 512),
+								 PartitionType::PRIMARY);
+	BlkFilesystem* blk_filesystem = partition->create_blk_filesystem(FsType::EXT4);
+	blk_filesystem->create_mount_point("/data/" + to_string(i) + "/" + to_string(j));
+    }
+}
+
+
+/**
+ * Returns the minimal time of several runs for the actiongraph generation
+ * with n disks.
+ */
+double
+measure(int n)
+{
+    Environment environment(true, ProbeMode::NONE, TargetMode::DIRECT);
+
+    Storage storage(environment);
+
+    Devicegraph* lhs = storage.create_devicegraph("lhs");
+
+    for (int i = 0; i < n; ++i)
+	add_disk(lhs, i);
+
+    Devicegraph* rhs = storage.copy_devicegraph("lhs", "rhs");
+
+    for (int i = 0; i < n; ++i)
+	add_partitions(rhs, i);
+
+    double best = 0.0;
+
+    for (int run = 0; run < 3; ++run)
+    {
+	Stopwatch stopwatch;
+
+	Actiongraph actiongraph(storage, lhs, rhs);
+
+	double seconds = stopwatch.read();
+
+	if (run == 0 || seconds < best)
+	    best = seconds;
+    }
+
+    cout << "actiongraph for " << n << " disks: " << best << "s" << endl;
+
+    return best;
+}
+
+
+/**
+ * Reports whether the time for the actiongraph generation grows roughly
+ * linearly with the number of devices. For quadratic growth the factor
+ * would be 16. Only a warning since the timing depends on the load of the
+ * machine.
+ */
+BOOST_AUTO_TEST_CASE(performance)
+{
+    const double t1 = measure(250);
+    const double t4 = measure(1000);
+
+    BOOST_WARN_LT(t4, 8.0 * t1);
+}
@@ -0,0 +1,309 @@
+
+/*
+ * Benchmark for the hot paths of devicegraphs and actiongraphs with
+ * devicegraphs of different sizes and storage stacks. Not run by "make
+ * check" but by "make benchmark" in the top-level directory.
+ *
+ * The output has one line per measurement with tab separated fields stack,
+ * devices, operation and seconds. For small devicegraphs the minimum of
+ * several runs is reported.
+ *
+ * Usage: benchmark [sizes...]
+ */
+
+
+#include <unistd.h>
+#include <stdlib.h>
+#include <iostream>
+#include <iomanip>
+#include <functional>
+#include <algorithm>
+#include <stdexcept>
+
+#include "storage/Devices/Disk.h"
+#include "storage/Devices/Gpt.h"
+#include "storage/Devices/Partition.h"
+#include "storage/Devices/LvmVg.h"
+#include "storage/Devices/LvmLv.h"
+#include "storage/Devices/Md.h"
+#include "storage/Devices/Encryption.h"
+#include "storage/Filesystems/Btrfs.h"
+#include "storage/Filesystems/BtrfsSubvolume.h"
+#include "storage/Devicegraph.h"
+#include "storage/Actiongraph.h"
+#include "storage/Storage.h"
+#include "storage/Environment.h"
+#include "storage/Utils/HumanString.h"
+#include "storage/Utils/Stopwatch.h"
+
+
+using namespace std;
+using namespace storage;
+
+
+struct Stack
+{
+    string name;
+
+    // Number of devices added per unit, used to calculate the number of
+    // units for the requested number of devices.
+    unsigned int devices_per_unit;
+
+    // Number of disks per unit.
+    unsigned int disks_per_unit;
+
+    // Adds the devices on top of the disks of unit i.
+    function<void(Devicegraph* devicegraph, unsigned int i)> add_unit;
+};
+
+
+string
+disk_name(unsigned int i)
+{
+    return "/dev/disk" + to_string(i);
+}
+
+
+Partition*
+add_partition(Devicegraph* devicegraph, unsigned int disk, unsigned int number, unsigned long long size)
+{
+    Disk* tmp = Disk::find_by_name(devicegraph, disk_name(disk));
+
+    PartitionTable* partition_table = tmp->has_partition_table() ? tmp->get_partition_table() :
+	tmp->create_partition_table(PtType::GPT);
+
+    const unsigned long long blocks = size / 512;
+
+    return partition_table->create_partition(disk_name(disk) + "p" + to_string(number),
+					     Region(2048 + (number - 1) * blocks, blocks, 512),
+					     PartitionType::PRIMARY);
+}
+
+
+void
+add_lvm_unit(Devicegraph* devicegraph, unsigned int i)
+{
+    Partition* partition = add_partition(devicegraph, i, 1, 64 * GiB);
+
+    LvmVg* lvm_vg = LvmVg::create(devicegraph, "vg" + to_string(i));
+    lvm_vg->add_lvm_pv(partition);
+
+    for (unsigned int j = 0; j < 4; ++j)
+    {
+	LvmLv* lvm_lv = lvm_vg->create_lvm_lv("lv" + to_string(j), LvType::NORMAL, 8 * GiB);
+	lvm_lv->create_blk_filesystem(FsType::EXT4);
+    }
+}
+
+
+void
+add_md_unit(Devicegraph* devicegraph, unsigned int i)
+{
+    Md* md = Md::create(devicegraph, "/dev/md" + to_string(i));
+    md->set_md_level(MdLevel::RAID1);
+
+    for (unsigned int j = 0; j < 2; ++j)
+	md->add_device(add_partition(devicegraph, 2 * i + j, 1, 64 * GiB));
+
+    md->create_blk_filesystem(FsType::XFS);
+}
+
+
+void
+add_luks_unit(Devicegraph* devicegraph, unsigned int i)
+{
+    for (unsigned int j = 1; j < 5; ++j)
+    {
+	Partition* partition = add_partition(devicegraph, i, j, 16 * GiB);
+
+	Encryption* encryption = partition->create_encryption("cr-" + to_string(i) + "-" + to_string(j),
+							      EncryptionType::LUKS2);
+	encryption->create_blk_filesystem(FsType::EXT4);
+    }
+}
+
+
+void
+add_btrfs_unit(Devicegraph* devicegraph, unsigned int i)
+{
+    Partition* partition = add_partition(devicegraph, i, 1, 64 * GiB);
+
+    Btrfs* btrfs = to_btrfs(partition->create_blk_filesystem(FsType::BTRFS));
+
+    BtrfsSubvolume* top_level = btrfs->get_top_level_btrfs_subvolume();
+
+    for (const char* path : { "@", "@/home", "@/opt", "@/root", "@/srv", "@/tmp", "@/usr/local", "@/var" })
+	top_level->create_btrfs_subvolume(path);
+}
+
+
+const vector<Stack> stacks = {
+    { "lvm", 13, 1, add_lvm_unit },
+    { "md", 8, 2, add_md_unit },
+    { "luks", 14, 1, add_luks_unit },
+    { "btrfs", 13, 1, add_btrfs_unit }
+};
+
+
+class Benchmark
+{
+public:
+
+    Benchmark(const Stack& stack, unsigned int size)
+	: stack(stack), units(max(1U, size / stack.devices_per_unit)), runs(size <= 1000 ? 5 : 1)
+    {
+    }
+
+    void run();
+
+private:
+
+    /**
+     * Runs func several times and prints the minimum time. setup is run
+     * before and teardown after each run and is not measured.
+     */
+    void measure(const string& operation, function<void()> func, function<void()> setup = nullptr,
+		 function<void()> teardown = nullptr);
+
+    const Stack& stack;
+    const unsigned int units;
+    const unsigned int runs;
+
+    unsigned int devices = 0;
+
+};
+
+
+void
+Benchmark::measure(const string& operation, function<void()> func, function<void()> setup,
+		   function<void()> teardown)
+{
+    double best = 0.0;
+
+    for (unsigned int run = 0; run < runs; ++run)
+    {
+	if (setup)
+	    setup();
+
+	Stopwatch stopwatch;
+
+	func();
+
+	double seconds = stopwatch.read();
+
+	if (run == 0 || seconds < best)
+	    best = seconds;
+
+	if (teardown)
+	    teardown();
+    }
+
+    cout << stack.name << '\t' << devices << '\t' << operation << '\t' << fixed << setprecision(6)
+	 << best << endl;
+}
+
+
+void
+Benchmark::run()
+{
+    Environment environment(true, ProbeMode::NONE, TargetMode::DIRECT);
+
+    Storage storage(environment);
+
+    // The lhs only has the disks, the rhs additionally the stacks.
+
+    Devicegraph* lhs = storage.create_devicegraph("lhs");
+
+    for (unsigned int i = 0; i < units * stack.disks_per_unit; ++i)
+	Disk::create(lhs, disk_name(i), 1 * TiB);
+
+    Devicegraph* rhs = nullptr;
+
+    auto copy_lhs = [&storage, &rhs]() { rhs = storage.copy_devicegraph("lhs", "rhs"); };
+    auto add_units = [this, &rhs]() {
+	for (unsigned int i = 0; i < units; ++i)
+	    stack.add_unit(rhs, i);
+    };
+    auto remove_rhs = [&storage]() { storage.remove_devicegraph("rhs"); };
+
+    // Run once to know the number of devices for the output.
+
+    copy_lhs();
+    add_units();
+    devices = rhs->num_devices();
+    remove_rhs();
+
+    measure("create", add_units, copy_lhs, remove_rhs);
+
+    copy_lhs();
+    add_units();
+
+    measure("copy", [&storage]() { storage.copy_devicegraph("rhs", "copy"); }, nullptr,
+	    [&storage]() { storage.remove_devicegraph("copy"); });
+
+    const Devicegraph* copy = storage.copy_devicegraph("rhs", "copy");
+
+    measure("equal", [rhs, copy]() {
+	if (*rhs != *copy)
+	    throw runtime_error("devicegraphs differ");
+    });
+
+    storage.remove_devicegraph("copy");
+
+    const string filename = "benchmark-" + stack.name + ".xml";
+
+    measure("save-xml", [rhs, &filename]() { rhs->save(filename); });
+
+    Devicegraph* loaded = storage.create_devicegraph("loaded");
+
+    measure("load-xml", [loaded, &filename]() { loaded->load(filename, true); });
+    measure("load-xml-lazy", [loaded, &filename]() { loaded->load(filename, true, true); });
+
+    storage.remove_devicegraph("loaded");
+
+    unlink(filename.c_str());
+
+    vector<string> names;
+    for (const BlkDevice* blk_device : BlkDevice::get_all(rhs))
+	names.push_back(blk_device->get_name());
+
+    measure("find-by-name", [rhs, &names]() {
+	for (const string& name : names)
+	    BlkDevice::find_by_name(rhs, name);
+    });
+
+    measure("check", [rhs]() { rhs->check(); });
+
+    measure("actiongraph", [&storage, lhs, rhs]() { Actiongraph actiongraph(storage, lhs, rhs); });
+
+    Actiongraph actiongraph(storage, lhs, rhs);
+
+    measure("compound-actions", [&actiongraph]() { actiongraph.generate_compound_actions(); });
+}
+
+
+int
+main(int argc, char** argv)
+{
+    vector<unsigned int> sizes = { 100, 1000, 10000, 50000 };
+
+    if (argc > 1)
+    {
+	sizes.clear();
+	for (int i = 1; i < argc; ++i)
+	    sizes.push_back(atoi(argv[i]));
+    }
+
+    cout << "stack\tdevices\toperation\tseconds" << endl;
+
+    for (unsigned int size : sizes)
+    {
+	for (const Stack& stack : stacks)
+	{
+	    Benchmark benchmark(stack, size);
+	    benchmark.run();
+	}
+    }
+
+    return EXIT_SUCCESS;
+}
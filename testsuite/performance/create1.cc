@@ -75,5 +75,5 @@ BOOST_AUTO_TEST_CASE(performance)
 
     Actiongraph actiongraph(storage, lhs, rhs);
 
-    // TODO actually fail if too slow? how can that be done stable?
+    // Timing is done by the benchmark, see benchmark.cc.
 }
@@ -0,0 +1,136 @@
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE libstorage
+
+#include <unistd.h>
+#include <iostream>
+#include <sstream>
+#include <boost/test/unit_test.hpp>
+
+#include "storage/Devices/Disk.h"
+#include "storage/Devices/PartitionTable.h"
+#include "storage/Devices/Partition.h"
+#include "storage/Filesystems/BlkFilesystem.h"
+#include "storage/Devicegraph.h"
+#include "storage/Storage.h"
+#include "storage/Environment.h"
+#include "storage/Utils/HumanString.h"
+#include "storage/Utils/Stopwatch.h"
+
+
+using namespace std;
+using namespace storage;
+
+
+string
+disk_name(int i)
+{
+    ostringstream s;
+    s << "/dev/disk" << i;
+    return s.str();
+}
+
+
+string
+partition_name(int i, int j)
+{
+    ostringstream s;
+    s << "/dev/disk" << i << "p" << j;
+    return s.str();
+}
+
+
+void
+add_disk(Devicegraph* devicegraph, int i)
+{
+    Disk* disk = Disk::create(devicegraph, disk_name(i), 1 * TiB);
+
+    PartitionTable* partition_table = disk->create_partition_table(PtType::GPT);
+
+    for (int j = 1; j < 5; ++j)
+    {
+	Partition* partition = partition_table->create_partition(partition_name(i, j),
+								 Region(j * 1048576, 1048576, 512),
+								 PartitionType::PRIMARY);
+	partition->create_blk_filesystem(FsType::EXT4);
+    }
+}
+
+
+/**
+ * Measures the time for saving, loading, also lazily, copying and
+ * destroying a large devicegraph.
+ */
+BOOST_AUTO_TEST_CASE(performance)
+{
+    Environment environment(true, ProbeMode::NONE, TargetMode::DIRECT);
+
+    Storage storage(environment);
+
+    const int n = 1000;
+
+    const string filename = "devicegraph-performance.xml";
+
+    {
+	Devicegraph* devicegraph = storage.create_devicegraph("tmp");
+
+	for (int i = 0; i < n; ++i)
+	    add_disk(devicegraph, i);
+
+	Stopwatch stopwatch;
+
+	devicegraph->save(filename);
+
+	cout << "save of " << devicegraph->num_devices() << " devices: " << stopwatch << endl;
+
+	storage.remove_devicegraph("tmp");
+    }
+
+    Devicegraph* devicegraph = storage.create_devicegraph("devicegraph");
+
+    {
+	Stopwatch stopwatch;
+
+	devicegraph->load(filename, true);
+
+	cout << "load of " << devicegraph->num_devices() << " devices: " << stopwatch << endl;
+    }
+
+    {
+	Stopwatch stopwatch;
+
+	devicegraph->load(filename, true, true);
+
+	cout << "lazy load of " << devicegraph->num_devices() << " devices: " << stopwatch << endl;
+    }
+
+    {
+	Stopwatch stopwatch;
+
+	devicegraph->check();
+
+	cout << "creating all " << devicegraph->num_devices() << " devices: " << stopwatch << endl;
+    }
+
+    unlink(filename.c_str());
+
+    {
+	Stopwatch stopwatch;
+
+	for (int i = 0; i < 10; ++i)
+	    storage.copy_devicegraph("devicegraph", "copy" + to_string(i));
+
+	cout << "copy 10 times: " << stopwatch << endl;
+    }
+
+    {
+	Stopwatch stopwatch;
+
+	for (int i = 0; i < 10; ++i)
+	    storage.remove_devicegraph("copy" + to_string(i));
+
+	cout << "teardown 10 times: " << stopwatch << endl;
+    }
+
+    BOOST_CHECK_EQUAL(devicegraph->num_devices(), 10 * n);
+}
@@ -0,0 +1,80 @@
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE libstorage
+
+#include <iostream>
+#include <sstream>
+#include <boost/test/unit_test.hpp>
+
+#include "storage/Devices/Disk.h"
+#include "storage/DevicegraphImpl.h"
+#include "storage/Storage.h"
+#include "storage/Environment.h"
+#include "storage/Utils/Stopwatch.h"
+
+
+using namespace std;
+using namespace storage;
+
+
+string
+disk_name(int i)
+{
+    ostringstream s;
+    s << "/dev/disk" << i;
+    return s.str();
+}
+
+
+/**
+ * Lookup of the vertex by iterating all vertices. That is what find_device() did
+ * before the sid index was introduced and is only used as a reference here.
+ */
+const Device*
+find_device_by_scan(const Devicegraph* devicegraph, sid_t sid)
+{
+    const Devicegraph::Impl& impl = devicegraph->get_impl();
+
+    for (Devicegraph::Impl::vertex_descriptor vertex : impl.vertices())
+    {
+	if (impl[vertex]->get_sid() == sid)
+	    return impl[vertex];
+    }
+
+    return nullptr;
+}
+
+
+BOOST_AUTO_TEST_CASE(performance)
+{
+    Environment environment(true, ProbeMode::NONE, TargetMode::DIRECT);
+
+    Storage storage(environment);
+
+    Devicegraph* devicegraph = storage.create_devicegraph("devicegraph");
+
+    const int n = 10000;
+
+    vector<sid_t> sids;
+
+    for (int i = 0; i < n; ++i)
+	sids.push_back(Disk::create(devicegraph, disk_name(i))->get_sid());
+
+    {
+	Stopwatch stopwatch;
+
+	for (sid_t sid : sids)
+	    BOOST_REQUIRE(devicegraph->find_device(sid));
+
+	cout << "find_device with index for " << n << " devices: " << stopwatch << endl;
+    }
+
+    {
+	Stopwatch stopwatch;
+
+	for (sid_t sid : sids)
+	    BOOST_REQUIRE(find_device_by_scan(devicegraph, sid));
+
+	cout << "find_device with scan for " << n << " devices: " << stopwatch << endl;
+    }
+}
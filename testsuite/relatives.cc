@@ -112,4 +112,17 @@ BOOST_AUTO_TEST_CASE(dependencies)
 
     BOOST_CHECK_EQUAL(sort(sda1->get_roots(false)), sort({ sda }));
     BOOST_CHECK_EQUAL(sort(system_swap->get_roots(false)), sort({ sda, sdb }));
+
+    // Results are memoized. Changing the structure must invalidate them.
+
+    Ext4* ext4 = to_ext4(system_root->create_blk_filesystem(FsType::EXT4));
+
+    BOOST_CHECK_EQUAL(sort(system->get_descendants(true)), sort({ system, system_root, system_home, system_swap, ext4 }));
+    BOOST_CHECK_EQUAL(sort(system->get_leaves(false)), sort({ ext4, system_swap, system_home }));
+    BOOST_CHECK_EQUAL(sort(ext4->get_roots(false)), sort({ sda, sdb }));
+
+    devicegraph->remove_device(sdb1);
+
+    BOOST_CHECK_EQUAL(sort(system->get_ancestors(true)), sort({ system, sda1, msdos, sda }));
+    BOOST_CHECK_EQUAL(sort(ext4->get_roots(false)), sort({ sda }));
 }
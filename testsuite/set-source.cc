@@ -54,6 +54,10 @@ BOOST_AUTO_TEST_CASE(test1)
     Holder* holder = staging->find_holder(sda->get_sid(), gpt->get_sid());
     holder->set_source(sdb);
 
+    BOOST_CHECK(!staging->holder_exists(sda->get_sid(), gpt->get_sid()));
+    BOOST_CHECK(staging->holder_exists(sdb->get_sid(), gpt->get_sid()));
+    BOOST_CHECK_EQUAL(staging->find_holders(sdb->get_sid(), gpt->get_sid()).size(), 1);
+
     BOOST_CHECK_EQUAL(sda1->get_name(), "/dev/sdb1");
     BOOST_CHECK_EQUAL(sda1->get_sysfs_name(), "sdb1");
     BOOST_CHECK_EQUAL(sda1->get_sysfs_path(), "/devices/pci0000:00/0000:00:1f.2/ata2/host1/target1:0:0/1:0:0:0/block/sdb/sdb1");
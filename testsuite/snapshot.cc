@@ -0,0 +1,49 @@
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE libstorage
+
+#include <boost/test/unit_test.hpp>
+
+#include "storage/Devices/Disk.h"
+#include "storage/Devicegraph.h"
+#include "storage/Storage.h"
+#include "storage/Environment.h"
+
+
+using namespace std;
+using namespace storage;
+
+
+BOOST_AUTO_TEST_CASE(snapshot)
+{
+    set_logger(get_stdout_logger());
+
+    Environment environment(true, ProbeMode::READ_DEVICEGRAPH, TargetMode::DIRECT);
+    environment.set_devicegraph_filename("probe.xml");
+
+    Storage storage(environment);
+
+    shared_ptr<const Devicegraph> empty = storage.get_probed_snapshot();
+    BOOST_CHECK(empty->empty());
+
+    storage.probe();
+
+    shared_ptr<const Devicegraph> probed = storage.get_probed_snapshot();
+    shared_ptr<const Devicegraph> system = storage.get_system_snapshot();
+
+    // The snapshots are copies.
+
+    BOOST_CHECK(probed.get() != storage.get_probed());
+    BOOST_CHECK(*probed == *storage.get_probed());
+    BOOST_CHECK(*system == *storage.get_system());
+
+    // Snapshots held by the caller are not affected by probing again.
+
+    const Disk* sda = Disk::find_by_name(probed.get(), "/dev/sda");
+
+    storage.probe();
+
+    BOOST_CHECK(empty->empty());
+    BOOST_CHECK_EQUAL(Disk::find_by_name(probed.get(), "/dev/sda"), sda);
+    BOOST_CHECK(storage.get_probed_snapshot() != probed);
+}
@@ -0,0 +1,52 @@
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE libstorage
+
+#include <boost/test/unit_test.hpp>
+
+#include "storage/Devices/Disk.h"
+#include "storage/Devicegraph.h"
+#include "storage/Environment.h"
+#include "storage/Storage.h"
+#include "storage/Utils/HumanString.h"
+
+
+using namespace std;
+using namespace storage;
+
+
+BOOST_AUTO_TEST_CASE(statistics)
+{
+    Environment environment(true, ProbeMode::NONE, TargetMode::DIRECT);
+
+    Storage storage(environment);
+
+    Devicegraph* staging = storage.get_staging();
+
+    Disk* sda = Disk::create(staging, "/dev/sda", 1 * TiB);
+
+    // Disabled by default.
+
+    storage.reset_devicegraph_statistics();
+
+    sda->get_descendants(false);
+
+    BOOST_CHECK_EQUAL(storage.get_devicegraph_statistics().traversals, 0);
+
+    storage.set_devicegraph_statistics_enabled(true);
+
+    staging->find_device(sda->get_sid());
+    sda->get_ancestors(false);
+    storage.copy_devicegraph("staging", "copy");
+
+    DevicegraphStatistics statistics = storage.get_devicegraph_statistics();
+
+    BOOST_CHECK_GE(statistics.find_vertex, 1);
+    BOOST_CHECK_EQUAL(statistics.traversals, 1);
+    BOOST_CHECK_EQUAL(statistics.copies, 1);
+
+    storage.set_devicegraph_statistics_enabled(false);
+    storage.reset_devicegraph_statistics();
+
+    BOOST_CHECK_EQUAL(storage.get_devicegraph_statistics().find_vertex, 0);
+}